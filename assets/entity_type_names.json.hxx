@@ -0,0 +1,222 @@
+const unsigned char ENTITY_TYPE_NAMES_JSON[] = { 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x69, 0x72, 0x6f, 0x5f, 0x31, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x6f, 0x6c, 0x64, 0x5f, 0x6d, 0x61, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x73, 0x73, 0x61, 0x6e, 0x5f, 0x62, 0x65, 0x61, 0x72, 0x5f, 
+0x6d, 0x61, 0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x62, 0x6f, 0x79, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6f, 0x72, 0x63, 0x5f, 0x79, 0x65, 0x6c, 0x6c, 0x6f, 
+0x77, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6f, 0x72, 0x63, 0x5f, 0x64, 0x61, 0x72, 
+0x6b, 0x5f, 0x72, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6f, 0x72, 0x63, 
+0x5f, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x5f, 0x72, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x77, 0x6f, 0x72, 0x6d, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x77, 0x6f, 0x72, 0x6d, 0x5f, 0x72, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x77, 0x6f, 0x72, 0x6d, 0x5f, 0x62, 0x6c, 0x75, 0x65, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x6f, 0x6e, 0x65, 0x79, 0x5f, 0x62, 0x61, 0x67, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x6e, 0x5f, 0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x77, 0x6f, 0x6d, 0x61, 0x6e, 0x5f, 0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x67, 0x69, 0x72, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x64, 0x6f, 
+0x67, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x63, 0x68, 0x69, 0x63, 0x6b, 0x65, 0x6e, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x70, 0x72, 0x69, 0x65, 0x73, 0x74, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x76, 0x61, 0x73, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x63, 0x68, 0x65, 0x73, 0x74, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 
+0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x67, 0x72, 0x61, 0x79, 0x5f, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x67, 0x72, 0x61, 0x79, 
+0x5f, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 
+0x6c, 0x6c, 0x5f, 0x79, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 
+0x72, 0x6d, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x63, 0x72, 0x61, 0x74, 0x65, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6e, 0x69, 0x6e, 0x6a, 0x61, 0x5f, 0x62, 0x6c, 0x61, 
+0x63, 0x6b, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6e, 0x69, 0x6e, 0x6a, 0x61, 0x5f, 
+0x72, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6e, 0x69, 0x6e, 0x6a, 0x61, 
+0x5f, 0x70, 0x75, 0x72, 0x70, 0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 
+0x69, 0x7a, 0x61, 0x72, 0x64, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x6c, 0x69, 0x7a, 0x61, 0x72, 0x64, 0x5f, 0x72, 0x65, 0x64, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 0x69, 0x7a, 0x61, 0x72, 0x64, 0x5f, 0x62, 0x6c, 0x75, 0x65, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6b, 0x6e, 0x69, 0x67, 0x68, 0x74, 0x5f, 0x74, 
+0x65, 0x61, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6b, 0x6e, 0x69, 0x67, 0x68, 
+0x74, 0x5f, 0x77, 0x68, 0x69, 0x74, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6b, 
+0x6e, 0x69, 0x67, 0x68, 0x74, 0x5f, 0x67, 0x6f, 0x6c, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x67, 0x68, 0x6f, 0x73, 0x74, 0x5f, 0x67, 0x72, 0x61, 0x79, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x67, 0x68, 0x6f, 0x73, 0x74, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x68, 0x6f, 0x73, 0x74, 0x5f, 0x62, 0x6c, 0x75, 
+0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x75, 0x6d, 0x6d, 0x79, 0x5f, 0x77, 
+0x68, 0x69, 0x74, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x75, 0x6d, 0x6d, 
+0x79, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 
+0x75, 0x6d, 0x6d, 0x79, 0x5f, 0x72, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x75, 0x6e, 0x69, 0x63, 0x6f, 0x72, 0x6e, 0x5f, 0x62, 0x6c, 0x75, 0x65, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x75, 0x6e, 0x69, 0x63, 0x6f, 0x72, 0x6e, 0x5f, 0x72, 0x65, 0x64, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x75, 0x6e, 0x69, 0x63, 0x6f, 0x72, 0x6e, 0x5f, 0x67, 
+0x72, 0x65, 0x65, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6b, 0x65, 0x6c, 
+0x65, 0x74, 0x6f, 0x6e, 0x5f, 0x77, 0x68, 0x69, 0x74, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x73, 0x6b, 0x65, 0x6c, 0x65, 0x74, 0x6f, 0x6e, 0x5f, 0x70, 0x75, 0x72, 0x70, 0x6c, 
+0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6b, 0x65, 0x6c, 0x65, 0x74, 0x6f, 
+0x6e, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 
+0x69, 0x6d, 0x69, 0x63, 0x5f, 0x62, 0x6c, 0x61, 0x63, 0x6b, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x6d, 0x69, 0x6d, 0x69, 0x63, 0x5f, 0x62, 0x72, 0x6f, 0x77, 0x6e, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x69, 0x6d, 0x69, 0x63, 0x5f, 0x62, 0x6c, 0x75, 0x65, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x73, 0x73, 0x61, 0x6e, 0x5f, 0x62, 0x65, 
+0x61, 0x72, 0x5f, 0x63, 0x68, 0x69, 0x6c, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x64, 0x77, 0x61, 0x72, 0x66, 0x5f, 0x6d, 0x61, 0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x67, 0x75, 0x6d, 0x69, 0x5f, 0x62, 0x65, 0x61, 0x72, 0x5f, 0x66, 0x65, 0x6d, 0x61, 
+0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6f, 0x6c, 0x64, 0x69, 0x65, 
+0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x64, 0x61, 0x6d, 0x65, 0x5f, 
+0x79, 0x61, 0x72, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x64, 0x65, 0x78, 0x74, 
+0x65, 0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x72, 0x61, 0x66, 0x74, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x75, 0x73, 0x68, 0x72, 0x6f, 0x6f, 0x6d, 0x5f, 0x67, 
+0x72, 0x65, 0x65, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x75, 0x73, 0x68, 
+0x72, 0x6f, 0x6f, 0x6d, 0x5f, 0x72, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x6d, 0x75, 0x73, 0x68, 0x72, 0x6f, 0x6f, 0x6d, 0x5f, 0x62, 0x6c, 0x61, 0x63, 0x6b, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x69, 0x61, 0x6e, 0x74, 0x5f, 0x70, 0x75, 0x72, 0x70, 
+0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x69, 0x61, 0x6e, 0x74, 0x5f, 
+0x62, 0x72, 0x6f, 0x77, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x69, 0x61, 
+0x6e, 0x74, 0x5f, 0x62, 0x6c, 0x61, 0x63, 0x6b, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x73, 0x6c, 0x69, 0x6d, 0x65, 0x5f, 0x77, 0x68, 0x69, 0x74, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x73, 0x6c, 0x69, 0x6d, 0x65, 0x5f, 0x62, 0x6c, 0x75, 0x65, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6c, 0x69, 0x6d, 0x65, 0x5f, 0x62, 0x72, 0x6f, 0x77, 0x6e, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6f, 0x6c, 0x64, 0x5f, 0x6c, 0x61, 0x64, 0x79, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x75, 0x6d, 0x69, 0x5f, 0x62, 0x65, 0x61, 
+0x72, 0x5f, 0x6d, 0x61, 0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x75, 
+0x6d, 0x69, 0x5f, 0x62, 0x65, 0x61, 0x72, 0x5f, 0x63, 0x68, 0x69, 0x6c, 0x64, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x66, 0x61, 0x72, 0x61, 0x5f, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x75, 0x6d, 0x69, 0x5f, 0x62, 0x65, 0x61, 0x72, 
+0x5f, 0x70, 0x72, 0x61, 0x79, 0x69, 0x6e, 0x67, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x73, 0x6b, 0x65, 0x6c, 0x65, 0x74, 0x6f, 0x6e, 0x5f, 0x73, 0x74, 0x61, 0x74, 0x75, 0x65, 0x5f, 
+0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x73, 0x73, 0x61, 0x6e, 0x5f, 
+0x62, 0x65, 0x61, 0x72, 0x5f, 0x70, 0x72, 0x61, 0x79, 0x69, 0x6e, 0x67, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x73, 0x6b, 0x65, 0x6c, 0x65, 0x74, 0x6f, 0x6e, 0x5f, 0x73, 0x74, 0x61, 
+0x74, 0x75, 0x65, 0x5f, 0x32, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x73, 
+0x73, 0x61, 0x6e, 0x5f, 0x62, 0x65, 0x61, 0x72, 0x5f, 0x66, 0x65, 0x6d, 0x61, 0x6c, 0x65, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x64, 0x77, 0x61, 0x72, 0x66, 0x5f, 0x66, 0x65, 0x6d, 
+0x61, 0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 
+0x5f, 0x67, 0x72, 0x61, 0x79, 0x5f, 0x73, 0x70, 0x69, 0x6b, 0x65, 0x62, 0x61, 0x6c, 0x6c, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x67, 0x72, 0x61, 
+0x79, 0x5f, 0x73, 0x70, 0x69, 0x6b, 0x65, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x73, 0x61, 0x63, 0x72, 0x65, 0x64, 0x5f, 0x74, 0x72, 0x65, 0x65, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x77, 0x6f, 0x6f, 0x64, 
+0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x69, 0x6e, 0x6a, 0x75, 0x72, 0x65, 0x64, 0x5f, 0x64, 0x6f, 0x67, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x64, 0x65, 0x61, 0x64, 0x5f, 0x62, 0x6f, 0x64, 0x79, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x77, 0x6f, 0x6d, 0x61, 0x6e, 0x5f, 0x32, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x6e, 0x5f, 0x32, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x69, 0x6e, 0x76, 0x69, 0x73, 0x69, 0x62, 0x6c, 0x65, 0x5f, 0x63, 0x75, 0x62, 0x65, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x69, 0x6e, 0x6b, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x63, 0x6f, 0x6e, 0x63, 0x72, 0x65, 0x74, 0x65, 
+0x5f, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x71, 
+0x75, 0x61, 0x72, 0x65, 0x5f, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x5f, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x79, 0x65, 0x6c, 
+0x6c, 0x6f, 0x77, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x5f, 0x61, 0x6c, 0x74, 
+0x65, 0x72, 0x6e, 0x61, 0x74, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 
+0x61, 0x6c, 0x6c, 0x5f, 0x67, 0x72, 0x61, 0x79, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 
+0x6d, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x67, 
+0x72, 0x65, 0x65, 0x6e, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x74, 0x68, 0x69, 0x6e, 0x5f, 
+0x79, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x74, 0x68, 0x69, 
+0x6e, 0x5f, 0x67, 0x72, 0x61, 0x79, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x74, 0x68, 0x69, 
+0x6e, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x64, 0x61, 
+0x72, 0x6b, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x74, 0x68, 0x69, 0x6e, 0x5f, 0x67, 0x72, 
+0x61, 0x79, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x74, 0x68, 0x69, 0x6e, 0x5f, 0x67, 0x72, 
+0x65, 0x65, 0x6e, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x74, 0x68, 0x69, 0x6e, 0x5f, 0x79, 
+0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x69, 0x74, 0x65, 0x6d, 0x5f, 0x62, 0x6f, 0x78, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x66, 0x72, 0x69, 0x64, 0x61, 0x79, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x72, 0x6f, 0x63, 0x6b, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x6e, 0x69, 0x67, 0x65, 0x6c, 0x5f, 0x69, 0x6e, 0x5f, 0x62, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x67, 0x6f, 0x64, 0x64, 0x65, 0x73, 0x73, 0x5f, 0x73, 0x74, 0x61, 0x74, 
+0x75, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x74, 0x77, 0x6f, 0x5f, 0x77, 0x61, 
+0x79, 0x5f, 0x73, 0x69, 0x67, 0x6e, 0x70, 0x6f, 0x73, 0x74, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x74, 0x68, 0x72, 0x65, 0x65, 0x5f, 0x77, 0x61, 0x79, 0x5f, 0x73, 0x69, 0x67, 0x6e, 
+0x70, 0x6f, 0x73, 0x74, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x61, 0x74, 0x65, 
+0x5f, 0x73, 0x6f, 0x75, 0x74, 0x68, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x61, 
+0x74, 0x65, 0x5f, 0x6e, 0x6f, 0x72, 0x74, 0x68, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x6b, 0x61, 0x79, 0x6c, 0x61, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x77, 0x61, 0x6c, 
+0x6c, 0x79, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x77, 0x6f, 0x6d, 0x61, 0x6e, 0x5f, 
+0x33, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 0x6f, 0x63, 0x6b, 0x65, 0x64, 0x5f, 
+0x64, 0x6f, 0x6f, 0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x6e, 0x5f, 
+0x69, 0x6e, 0x5f, 0x62, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x61, 0x72, 
+0x74, 0x68, 0x75, 0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6b, 0x61, 0x79, 0x6c, 
+0x61, 0x5f, 0x69, 0x6e, 0x5f, 0x62, 0x61, 0x74, 0x68, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x64, 0x75, 0x6b, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 
+0x6c, 0x6c, 0x5f, 0x77, 0x6f, 0x6f, 0x64, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x74, 0x68, 
+0x69, 0x6e, 0x5f, 0x64, 0x61, 0x72, 0x6b, 0x5f, 0x70, 0x6c, 0x61, 0x74, 0x66, 0x6f, 0x72, 0x6d, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6f, 0x6c, 0x64, 0x5f, 0x6d, 0x61, 0x6e, 0x5f, 
+0x79, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 
+0x6e, 0x5f, 0x62, 0x6c, 0x75, 0x65, 0x5f, 0x73, 0x68, 0x69, 0x72, 0x74, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x63, 0x68, 0x65, 0x66, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x70, 0x72, 0x69, 0x6e, 0x63, 0x65, 0x73, 0x73, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x67, 0x6f, 0x6c, 0x65, 0x6d, 0x5f, 0x73, 0x74, 0x61, 0x74, 0x75, 0x65, 0x5f, 0x31, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x69, 0x72, 0x5f, 0x6d, 0x61, 0x67, 0x69, 0x63, 0x5f, 
+0x62, 0x61, 0x72, 0x72, 0x69, 0x65, 0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 
+0x61, 0x69, 0x6c, 0x6f, 0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x70, 0x6f, 0x63, 
+0x6b, 0x65, 0x74, 0x73, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6b, 0x65, 0x6c, 
+0x65, 0x74, 0x6f, 0x6e, 0x5f, 0x70, 0x72, 0x69, 0x65, 0x73, 0x74, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x6d, 0x69, 0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x62, 0x69, 
+0x72, 0x64, 0x5f, 0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x62, 0x69, 0x72, 0x64, 
+0x5f, 0x32, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x62, 0x69, 0x72, 0x64, 0x5f, 0x33, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x6f, 0x72, 0x61, 0x6c, 0x69, 0x73, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6c, 0x69, 0x6d, 0x65, 0x5f, 0x79, 0x65, 0x6c, 
+0x6c, 0x6f, 0x77, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6c, 0x69, 0x6d, 0x65, 
+0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6c, 
+0x69, 0x6d, 0x65, 0x5f, 0x70, 0x75, 0x72, 0x70, 0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x67, 0x6e, 0x6f, 0x6d, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x7a, 
+0x61, 0x6b, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x69, 0x72, 0x5f, 0x77, 0x61, 
+0x6c, 0x6c, 0x5f, 0x62, 0x61, 0x72, 0x72, 0x69, 0x65, 0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x66, 0x69, 0x72, 0x65, 0x62, 0x61, 0x6c, 0x6c, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x77, 0x69, 0x7a, 0x61, 0x72, 0x64, 0x5f, 0x62, 
+0x6c, 0x61, 0x63, 0x6b, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x77, 0x69, 0x7a, 0x61, 
+0x72, 0x64, 0x5f, 0x79, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x77, 0x69, 0x7a, 0x61, 0x72, 0x64, 0x5f, 0x33, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x67, 0x6f, 0x6c, 0x65, 0x6d, 0x5f, 0x73, 0x74, 0x61, 0x74, 0x75, 0x65, 0x5f, 0x32, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x63, 0x6f, 0x72, 0x72, 0x75, 0x70, 0x74, 0x65, 0x64, 
+0x5f, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x5f, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 
+0x5f, 0x73, 0x70, 0x69, 0x6b, 0x65, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x5f, 0x73, 0x70, 
+0x69, 0x6b, 0x65, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 
+0x68, 0x6f, 0x73, 0x74, 0x5f, 0x73, 0x70, 0x61, 0x77, 0x6e, 0x65, 0x72, 0x5f, 0x77, 0x68, 0x69, 
+0x74, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x68, 0x6f, 0x73, 0x74, 0x5f, 
+0x73, 0x70, 0x61, 0x77, 0x6e, 0x65, 0x72, 0x5f, 0x67, 0x72, 0x61, 0x79, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x67, 0x68, 0x6f, 0x73, 0x74, 0x5f, 0x73, 0x70, 0x61, 0x77, 0x6e, 0x65, 
+0x72, 0x5f, 0x6d, 0x65, 0x74, 0x61, 0x6c, 0x6c, 0x69, 0x63, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x67, 0x6f, 0x6c, 0x65, 0x6d, 0x5f, 0x67, 0x72, 0x65, 0x65, 0x6e, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x6f, 0x6c, 0x65, 0x6d, 0x5f, 0x77, 0x68, 0x69, 0x74, 0x65, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x6f, 0x6c, 0x65, 0x6d, 0x5f, 0x67, 0x6f, 
+0x6c, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x70, 0x65, 0x63, 0x74, 0x72, 
+0x65, 0x5f, 0x67, 0x72, 0x61, 0x79, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x70, 
+0x65, 0x63, 0x74, 0x72, 0x65, 0x5f, 0x6f, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x73, 0x70, 0x65, 0x63, 0x74, 0x72, 0x65, 0x5f, 0x70, 0x75, 0x72, 0x70, 
+0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 
+0x62, 0x6c, 0x75, 0x65, 0x5f, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x5f, 0x72, 0x65, 0x64, 0x5f, 0x62, 0x61, 0x6c, 0x6c, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x5f, 0x62, 0x6c, 0x75, 
+0x65, 0x5f, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6c, 0x61, 
+0x72, 0x67, 0x65, 0x5f, 0x72, 0x65, 0x64, 0x5f, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x6d, 0x61, 0x67, 0x69, 0x63, 0x5f, 0x66, 0x6f, 0x78, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x70, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x5f, 0x77, 0x68, 0x69, 
+0x74, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x64, 0x75, 0x6b, 0x65, 0x5f, 0x63, 
+0x68, 0x61, 0x69, 0x72, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6d, 0x69, 0x72, 0x6f, 
+0x5f, 0x32, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x66, 0x69, 0x72, 0x65, 0x64, 0x65, 
+0x6d, 0x6f, 0x6e, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x66, 0x69, 0x72, 0x65, 0x64, 
+0x65, 0x6d, 0x6f, 0x6e, 0x5f, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6c, 0x65, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x6f, 0x6c, 0x61, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x70, 0x69, 0x6e, 0x6b, 0x5f, 0x67, 0x6f, 0x6c, 0x65, 0x6d, 0x5f, 0x73, 0x74, 
+0x61, 0x74, 0x75, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x6f, 0x6c, 0x64, 
+0x5f, 0x67, 0x6f, 0x6c, 0x65, 0x6d, 0x5f, 0x73, 0x74, 0x61, 0x74, 0x75, 0x65, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x6e, 0x6f, 0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x6e, 0x6f, 0x6c, 0x65, 0x5f, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6c, 0x65, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x71, 0x75, 0x61, 0x6b, 0x65, 0x5f, 0x67, 0x72, 
+0x61, 0x79, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x7a, 0x61, 0x6b, 0x5f, 0x70, 0x72, 
+0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6c, 0x65, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x6f, 0x6e, 0x65, 0x5f, 0x77, 0x61, 0x79, 0x5f, 0x73, 0x69, 0x67, 0x6e, 0x5f, 0x70, 0x6f, 0x73, 
+0x74, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x73, 0x70, 0x69, 0x6e, 0x6e, 0x65, 0x72, 
+0x5f, 0x72, 0x65, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x71, 0x75, 0x61, 0x6b, 
+0x65, 0x5f, 0x67, 0x6f, 0x6c, 0x64, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x67, 0x6f, 
+0x6c, 0x61, 0x5f, 0x66, 0x69, 0x72, 0x65, 0x62, 0x61, 0x6c, 0x6c, 0x22, 0x0a, 0x5d, 0x00 };
+
+const size_t ENTITY_TYPE_NAMES_JSON_SIZE = 3487;
+
@@ -0,0 +1,59 @@
+const unsigned char FIXED_HUD_TILEMAP[] = { 
+0x8f, 0xff, 0x00, 0x01, 0x00, 0x01, 0x01, 0x01, 0xfe, 0xbb, 0xff, 0xff, 0xd7, 0xeb, 0xbe, 0x0f, 
+0x04, 0xee, 0x00, 0x1c, 0xff, 0xff, 0xbb, 0x52, 0x0f, 0x01, 0xee, 0x0f, 0x01, 0xaa, 0x0f, 0x01, 
+0x0f, 0x24, 0xea, 0x00, 0x04, 0x5f, 0x08, 0x04, 0xaa, 0x0c, 0x25, 0xaa, 0xaf, 0xbe, 0xee, 0xfa, 
+0xef, 0xaa, 0xfb, 0xef, 0x0b, 0x0c, 0xef, 0xfa, 0xfb, 0xee, 0xc5, 0xee, 0xff, 0x0e, 0x04, 0x00, 
+0x34, 0x0e, 0x78, 0xee, 0x0f, 0x80, 0xfe, 0x50, 0x0d, 0x7c, 0xaa, 0x00, 0x01, 0xaa, 0x0a, 0x80, 
+0x0e, 0x20, 0x0e, 0x44, 0x0e, 0x50, 0x85, 0xaa, 0x07, 0x2b, 0x06, 0x20, 0x00, 0x3e, 0x04, 0x01, 
+0xbf, 0x0f, 0x03, 0xab, 0xfc, 0xfa, 0xab, 0xfa, 0xaa, 0xbb, 0xbf, 0x00, 0x40, 0x06, 0x40, 0x0e, 
+0x0f, 0x20, 0x0e, 0x28, 0x0e, 0x30, 0x0e, 0x2a, 0xbf, 0xab, 0xbb, 0x0e, 0x08, 0x80, 0xbf, 0x00, 
+0x52, 0x08, 0x30, 0x0d, 0x94, 0x04, 0x38, 0x01, 0x04, 0x0f, 0x1d, 0x0f, 0x24, 0xf4, 0xfa, 0xaa, 
+0xab, 0xfb, 0x0f, 0x08, 0xab, 0x00, 0x04, 0x06, 0x40, 0x88, 0xaa, 0x09, 0x04, 0x0f, 0x31, 0x0e, 
+0x34, 0xfa, 0x04, 0x98, 0x0c, 0x1c, 0x0a, 0xcc, 0x40, 0x0d, 0x1e, 0xbf, 0x0b, 0x45, 0x0c, 0x61, 
+0x0e, 0x04, 0x0f, 0xee, 0x0c, 0xf2, 0x0c, 0x02, 0x5a, 0x0f, 0xeb, 0xfa, 0x07, 0x59, 0xaa, 0xbf, 
+0x0f, 0x3c, 0xbb, 0x0f, 0x34, 0x80, 0xba, 0x0a, 0x13, 0x02, 0xf8, 0x0b, 0x20, 0x0a, 0xc0, 0x0f, 
+0x40, 0x0b, 0xcc, 0x0e, 0x68, 0x00, 0x08, 0x83, 0x00, 0xc0, 0x0c, 0x30, 0x1a, 0x6c, 0x09, 0xb4, 
+0x10, 0x20, 0x0e, 0x24, 0x0e, 0x18, 0x0d, 0x07, 0x97, 0x0a, 0x4d, 0x07, 0x0f, 0x0a, 0x1e, 0xaa, 
+0xaf, 0x0f, 0x0d, 0xfb, 0xfe, 0xbf, 0xaa, 0xaf, 0xbf, 0xfb, 0xaa, 0xfb, 0x1f, 0x71, 0x6d, 0x0a, 
+0x04, 0xaf, 0xbf, 0x1f, 0x7d, 0xfb, 0xff, 0x08, 0x20, 0xbd, 0xfb, 0xdb, 0xaa, 0xfb, 0xdb, 0xbd, 
+0x0f, 0x04, 0xcc, 0xaa, 0xeb, 0xfb, 0xdd, 0xcc, 0x0f, 0x10, 0xdc, 0x0f, 0x18, 0xdd, 0xaa, 0xff, 
+0xff, 0xaf, 0xfa, 0xaf, 0xbb, 0xfb, 0xbf, 0xfb, 0xc6, 0xff, 0xbf, 0x0e, 0x05, 0x2f, 0x51, 0x0b, 
+0x04, 0xff, 0xbf, 0x0f, 0x08, 0x3d, 0x0f, 0x40, 0x0a, 0x20, 0xcf, 0xbd, 0xdb, 0xbc, 0x0f, 0x40, 
+0xdc, 0x5f, 0x0f, 0x40, 0xcc, 0x0f, 0x40, 0xcc, 0xcf, 0xbd, 0xdc, 0xcc, 0xba, 0xcb, 0x06, 0x40, 
+0xbd, 0xdb, 0xbf, 0x0f, 0x20, 0xff, 0x0f, 0x20, 0xbd, 0xff, 0x0f, 0x20, 0xff, 0xff, 0xbd, 0xdc, 
+0x0f, 0x40, 0xdd, 0x00, 0x20, 0x60, 0x23, 0x60, 0x17, 0x28, 0x00, 0x20, 0x0f, 0x86, 0x0b, 0xe7, 
+0x1e, 0x68, 0x00, 0x20, 0x00, 0x0d, 0x20, 0x00, 0x60, 0x07, 0x20, 0x0c, 0x38, 0x0a, 0x65, 0x00, 
+0x20, 0x00, 0x40, 0x00, 0x20, 0x00, 0x00, 0x20, 0x00, 0xc0, 0x07, 0x5f, 0x00, 0x40, 0x00, 0x40, 
+0x00, 0x20, 0x00, 0x20, 0x0d, 0x20, 0x14, 0x16, 0xfa, 0x00, 0x20, 0x3e, 0x61, 0xaf, 0x0e, 0x1b, 
+0xfb, 0x2e, 0x09, 0x00, 0x20, 0x4d, 0x0d, 0x20, 0xbd, 0x00, 0x20, 0x08, 0x20, 0xff, 0xbf, 0x2f, 
+0x39, 0xfa, 0x18, 0x2e, 0x21, 0x2d, 0x29, 0x01, 0x20, 0xdc, 0xbf, 0x2f, 0x39, 0x00, 0x20, 0x06, 
+0x40, 0x83, 0xbd, 0x00, 0x40, 0x07, 0x80, 0x0e, 0x82, 0x3f, 0x7f, 0x2f, 0x60, 0xaa, 0xbf, 0xf7, 
+0xff, 0xfb, 0xfa, 0xff, 0x09, 0x04, 0xbf, 0xaa, 0xff, 0x3f, 0x3e, 0xf4, 0x0a, 0x20, 0xcc, 0xbf, 
+0xaa, 0xbc, 0xcc, 0xcb, 0xb6, 0xfa, 0x2f, 0x55, 0xfa, 0xcc, 0x0d, 0x04, 0xbf, 0xaa, 0x0f, 0x07, 
+0x32, 0x0f, 0x1d, 0x2e, 0xc7, 0xbb, 0xfa, 0x2f, 0xcf, 0x2e, 0x9f, 0xfb, 0x2a, 0x9f, 0x1b, 0x0f, 
+0x10, 0x2b, 0xe8, 0x0b, 0x20, 0xbd, 0xcc, 0x2f, 0x7f, 0xbc, 0xcb, 0x73, 0x2d, 0x9f, 0xdc, 0xcc, 
+0xcc, 0x0f, 0x10, 0x2f, 0xe8, 0xdc, 0xcc, 0xc6, 0xab, 0xbf, 0x3f, 0xe0, 0x0f, 0x7d, 0x0f, 0x2f, 
+0xbf, 0xab, 0x0e, 0x71, 0x8f, 0xbf, 0x2b, 0x0f, 0x0b, 0x01, 0x0e, 0x20, 0xbd, 0xcb, 0xcc, 0xbf, 
+0x74, 0x0f, 0x2f, 0xbf, 0xab, 0xdc, 0x0f, 0x71, 0xbd, 0x00, 0x20, 0x00, 0x40, 0x85, 0xfa, 0x09, 
+0x1c, 0x00, 0x40, 0x04, 0x20, 0x00, 0x3c, 0xfa, 0x15, 0x20, 0xbd, 0x85, 0xdb, 0x00, 0x3c, 0x50, 
+0x80, 0x0c, 0x01, 0x0e, 0x56, 0xff, 0x07, 0x04, 0xfa, 0x29, 0x53, 0x73, 0x0e, 0x10, 0xcf, 0x0f, 
+0x04, 0xdf, 0x0b, 0x08, 0x0d, 0x30, 0xfe, 0xaf, 0xeb, 0x6f, 0x1c, 0xfe, 0x0f, 0x59, 0xfe, 0xef, 
+0xaa, 0xaf, 0x7f, 0x1c, 0xb3, 0xeb, 0xef, 0xbd, 0xff, 0xfe, 0xff, 0xca, 0x9f, 0xff, 0x60, 0x20, 
+0x1e, 0x6f, 0xaf, 0xff, 0xfb, 0xbc, 0xfb, 0xf8, 0xeb, 0xfb, 0xcf, 0xfe, 0xfe, 0x0e, 0x0c, 0x0f, 
+0x38, 0x1e, 0xa2, 0x90, 0xef, 0x0e, 0x44, 0x0e, 0x4c, 0xaf, 0x0f, 0x33, 0x25, 0x00, 0x00, 0x01, 
+0x79, 0x20, 0x23, 0x0e, 0x2c, 0x2e, 0xe1, 0xfb, 0x2b, 0xc0, 0x20, 0x20, 0x2e, 0x60, 0xaa, 0xaa, 
+0x83, 0xdb, 0x00, 0x20, 0x18, 0x00, 0x48, 0xc8, 0x29, 0xe8, 0x04, 0x20, 0xbd, 0xcc, 0x48, 0x0f, 
+0x17, 0xdc, 0x26, 0xe8, 0x10, 0x40, 0xaa, 0x7b, 0x87, 0x00, 0x01, 0x02, 0x20, 0xa2, 0xcf, 0x0f, 
+0x04, 0xdf, 0x0b, 0x08, 0x02, 0x20, 0x0e, 0x14, 0xdc, 0x1e, 0xb4, 0x4d, 0x0b, 0x08, 0xcf, 0x03, 
+0x20, 0x4f, 0xf5, 0xff, 0xdd, 0x0f, 0x15, 0xbb, 0xa5, 0xdf, 0x0c, 0x08, 0xcc, 0x02, 0x20, 0x0f, 
+0x14, 0xdd, 0x0f, 0x39, 0xbb, 0x85, 0xbd, 0x0c, 0x08, 0x0e, 0x10, 0x05, 0x20, 0x0f, 0x31, 0xdd, 
+0x0f, 0x39, 0xbb, 0x0a, 0x0f, 0x41, 0x0e, 0x08, 0x0e, 0x10, 0x04, 0x20, 0xcf, 0x0f, 0x18, 0xdc, 
+0x0f, 0x20, 0x8b, 0xbd, 0x0d, 0x08, 0x0e, 0x10, 0x04, 0x20, 0xcc, 0x0f, 0x18, 0xdd, 0xcf, 0x45, 
+0x0f, 0xff, 0xdf, 0x0e, 0x08, 0x0e, 0x10, 0x03, 0x20, 0xcf, 0x0f, 0x18, 0xdc, 0x45, 0x0f, 0x20, 
+0xbd, 0x0e, 0x08, 0x0e, 0x10, 0x03, 0x20, 0xcc, 0x0f, 0x18, 0xdd, 0x09, 0x1e, 0x40, 0x0e, 0x08, 
+0x0e, 0x10, 0x06, 0x20, 0xca, 0x0f, 0x04, 0x1f, 0x69, 0xaa, 0x90, 0xbd, 0x0b, 0x08, 0x0e, 0x10, 
+0x00, 0x00, 0x01, 0x05, 0x01, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+const size_t FIXED_HUD_TILEMAP_SIZE = 874;
+
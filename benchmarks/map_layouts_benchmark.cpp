@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../io/io.hpp"
+#include "../model/map_layout.hpp"
+#include "../constants/offsets.hpp"
+#include "../tools/byte_array.hpp"
+#include "../tools/json.hpp"
+
+struct LayoutMeasures {
+    uint32_t address = 0;
+    uint16_t first_map_id = 0;
+    size_t map_count = 0;
+    double vanilla_decode_time = 0;
+
+    size_t vanilla_size = 0;
+    double vanilla_encode_time = 0;
+    bool vanilla_round_trip = false;
+
+    size_t new_format_size = 0;
+    double new_format_encode_time = 0;
+    double new_format_decode_time = 0;
+    bool new_format_round_trip = false;
+    size_t incrementing_runs_size = 0;
+
+    [[nodiscard]] Json to_json() const
+    {
+        Json json;
+        json["address"] = address;
+        json["firstMapId"] = first_map_id;
+        json["mapCount"] = map_count;
+        json["vanillaDecodeTime"] = vanilla_decode_time;
+        json["vanillaSize"] = vanilla_size;
+        json["vanillaEncodeTime"] = vanilla_encode_time;
+        json["vanillaRoundTrip"] = vanilla_round_trip;
+        json["newFormatSize"] = new_format_size;
+        json["newFormatEncodeTime"] = new_format_encode_time;
+        json["newFormatDecodeTime"] = new_format_decode_time;
+        json["newFormatRoundTrip"] = new_format_round_trip;
+        json["incrementingRunsSize"] = incrementing_runs_size;
+        return json;
+    }
+};
+
+/**
+ * Calls `func` `iterations` times and returns the average time taken by one call in microseconds
+ */
+template<typename Func>
+static double measure(size_t iterations, Func&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i=0 ; i<iterations ; ++i)
+        func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / (double)iterations;
+}
+
+/**
+ * @return true if both blocks hold the same values, considering missing trailing values as default values
+ */
+static bool same_data_block(const std::vector<uint16_t>& a, const std::vector<uint16_t>& b, uint16_t default_value)
+{
+    for(size_t i=0 ; i<std::max(a.size(), b.size()) ; ++i)
+    {
+        uint16_t value_a = (i < a.size()) ? a[i] : default_value;
+        uint16_t value_b = (i < b.size()) ? b[i] : default_value;
+        if(value_a != value_b)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * New format does not store layout heights, so decoded layouts can only be compared to original ones
+ * up to trailing default values
+ */
+static bool same_layout_data(const MapLayout& a, const MapLayout& b)
+{
+    return a.left() == b.left() && a.top() == b.top() && a.width() == b.width()
+        && a.heightmap_width() == b.heightmap_width()
+        && same_data_block(a.foreground_tiles(), b.foreground_tiles(), 0x0000)
+        && same_data_block(a.background_tiles(), b.background_tiles(), 0x0000)
+        && same_data_block(a.heightmap(), b.heightmap(), 0x4000);
+}
+
+/**
+ * @return the (up to) `count` layouts having the highest value for `key`, highest first
+ */
+template<typename Key>
+static Json top_layouts(const std::vector<LayoutMeasures>& layouts, size_t count, Key&& key)
+{
+    std::vector<const LayoutMeasures*> sorted_layouts;
+    for(const LayoutMeasures& layout : layouts)
+        sorted_layouts.emplace_back(&layout);
+    std::stable_sort(sorted_layouts.begin(), sorted_layouts.end(), [&key](const LayoutMeasures* a, const LayoutMeasures* b) {
+        return key(*a) > key(*b);
+    });
+
+    Json json = Json::array();
+    for(size_t i=0 ; i<std::min(count, sorted_layouts.size()) ; ++i)
+        json.emplace_back(sorted_layouts[i]->to_json());
+    return json;
+}
+
+/**
+ * Decodes every map layout from a vanilla ROM, then re-encodes each one using the vanilla encoder and the new format
+ * encoder (with and without incrementing runs), checking that both encodings decode back to the same layout.
+ * Sizes and times (in microseconds, averaged over iterations) are written for each layout in a CSV file, and totals
+ * along with the biggest outliers in a JSON file.
+ *
+ * Usage: map_layouts_benchmark <rom_path> [iterations] [output_prefix]
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <rom_path> [iterations] [output_prefix]" << std::endl;
+        return 1;
+    }
+
+    md::ROM rom(argv[1]);
+    if(!rom.is_valid())
+    {
+        std::cerr << "Could not open ROM '" << argv[1] << "'" << std::endl;
+        return 1;
+    }
+
+    size_t iterations = (argc >= 3) ? std::max<size_t>(std::stoul(argv[2]), 1) : 5;
+    std::string output_prefix = (argc >= 4) ? argv[3] : "map_layouts_benchmark";
+
+    // Several maps can share the same layout, only measure each layout once
+    constexpr uint16_t MAP_COUNT = 816;
+    std::vector<LayoutMeasures> layouts;
+    std::map<uint32_t, size_t> layout_ids_by_address;
+    for(uint16_t map_id = 0 ; map_id < MAP_COUNT ; ++map_id)
+    {
+        uint32_t layout_addr = rom.get_long(offsets::MAP_DATA_TABLE + (map_id * 8));
+        auto [it, inserted] = layout_ids_by_address.try_emplace(layout_addr, layouts.size());
+        if(inserted)
+        {
+            LayoutMeasures& layout = layouts.emplace_back();
+            layout.address = layout_addr;
+            layout.first_map_id = map_id;
+        }
+        layouts[it->second].map_count++;
+    }
+
+    // Encoded layouts are written one after the other inside a copy of the ROM to be decoded back from there, since
+    // a ROM does not allow overwriting the same bytes twice
+    md::ROM scratch_rom = rom;
+    uint32_t scratch_addr = 0;
+    auto write_in_scratch_rom = [&](const ByteArray& bytes) -> uint32_t {
+        if(scratch_addr + bytes.size() > scratch_rom.size())
+        {
+            scratch_rom = rom;
+            scratch_addr = 0;
+        }
+        uint32_t addr = scratch_addr;
+        scratch_rom.set_bytes(addr, bytes);
+        scratch_addr += bytes.size();
+        return addr;
+    };
+
+    size_t failed_round_trips = 0;
+    for(LayoutMeasures& measures : layouts)
+    {
+        MapLayout* layout = nullptr;
+        measures.vanilla_decode_time = measure(iterations, [&]() {
+            delete layout;
+            layout = io::decode_map_layout(rom, measures.address);
+        });
+
+        ByteArray vanilla_bytes;
+        measures.vanilla_encode_time = measure(iterations, [&]() { vanilla_bytes = io::encode_map_layout_old(layout); });
+        measures.vanilla_size = vanilla_bytes.size();
+
+        uint32_t vanilla_addr = write_in_scratch_rom(vanilla_bytes);
+        MapLayout* decoded_layout = io::decode_map_layout(scratch_rom, vanilla_addr);
+        measures.vanilla_round_trip = (*decoded_layout == *layout);
+        delete decoded_layout;
+        decoded_layout = nullptr;
+        if(!measures.vanilla_round_trip)
+        {
+            std::cerr << "Layout at address " << measures.address << " does not round-trip through the vanilla encoder" << std::endl;
+            ++failed_round_trips;
+        }
+
+        ByteArray new_format_bytes;
+        measures.new_format_encode_time = measure(iterations, [&]() { new_format_bytes = io::encode_map_layout(layout); });
+        measures.new_format_size = new_format_bytes.size();
+        measures.incrementing_runs_size = io::encode_map_layout(layout, true).size();
+
+        uint32_t new_format_addr = write_in_scratch_rom(new_format_bytes);
+        measures.new_format_decode_time = measure(iterations, [&]() {
+            delete decoded_layout;
+            decoded_layout = io::decode_map_layout_new(scratch_rom, new_format_addr);
+        });
+        measures.new_format_round_trip = same_layout_data(*decoded_layout, *layout);
+        delete decoded_layout;
+        if(!measures.new_format_round_trip)
+        {
+            std::cerr << "Layout at address " << measures.address << " does not round-trip through the new format encoder" << std::endl;
+            ++failed_round_trips;
+        }
+
+        delete layout;
+    }
+
+    std::ofstream csv(output_prefix + ".csv");
+    csv << "address,firstMapId,mapCount,vanillaDecodeTime,vanillaSize,vanillaEncodeTime,vanillaRoundTrip,"
+           "newFormatSize,newFormatEncodeTime,newFormatDecodeTime,newFormatRoundTrip,incrementingRunsSize\n";
+    for(const LayoutMeasures& m : layouts)
+    {
+        csv << m.address << "," << m.first_map_id << "," << m.map_count << "," << m.vanilla_decode_time << ","
+            << m.vanilla_size << "," << m.vanilla_encode_time << "," << m.vanilla_round_trip << ","
+            << m.new_format_size << "," << m.new_format_encode_time << "," << m.new_format_decode_time << ","
+            << m.new_format_round_trip << "," << m.incrementing_runs_size << "\n";
+    }
+    csv.close();
+
+    LayoutMeasures totals;
+    for(const LayoutMeasures& m : layouts)
+    {
+        totals.map_count += m.map_count;
+        totals.vanilla_decode_time += m.vanilla_decode_time;
+        totals.vanilla_size += m.vanilla_size;
+        totals.vanilla_encode_time += m.vanilla_encode_time;
+        totals.new_format_size += m.new_format_size;
+        totals.new_format_encode_time += m.new_format_encode_time;
+        totals.new_format_decode_time += m.new_format_decode_time;
+        totals.incrementing_runs_size += m.incrementing_runs_size;
+    }
+
+    Json report;
+    report["layoutCount"] = layouts.size();
+    report["iterations"] = iterations;
+    report["failedRoundTrips"] = failed_round_trips;
+    report["totals"] = totals.to_json();
+    report["totals"].erase("address");
+    report["totals"].erase("firstMapId");
+    report["totals"].erase("vanillaRoundTrip");
+    report["totals"].erase("newFormatRoundTrip");
+    report["biggestNewFormatOverheads"] = top_layouts(layouts, 10, [](const LayoutMeasures& m) {
+        return (double)m.new_format_size / (double)std::max<size_t>(m.vanilla_size, 1);
+    });
+    report["slowestVanillaEncodes"] = top_layouts(layouts, 10, [](const LayoutMeasures& m) {
+        return m.vanilla_encode_time;
+    });
+    dump_json_to_file(report, output_prefix + ".json");
+
+    std::cout << "Measured " << layouts.size() << " map layouts used by " << totals.map_count << " maps ("
+              << iterations << " iterations)" << std::endl;
+    std::cout << "  Vanilla format:                    " << totals.vanilla_size << " bytes, encoded in "
+              << totals.vanilla_encode_time << " us, decoded in " << totals.vanilla_decode_time << " us" << std::endl;
+    std::cout << "  New format:                        " << totals.new_format_size << " bytes, encoded in "
+              << totals.new_format_encode_time << " us, decoded in " << totals.new_format_decode_time << " us" << std::endl;
+    std::cout << "  New format with incrementing runs: " << totals.incrementing_runs_size << " bytes" << std::endl;
+    std::cout << "Detailed results written to " << output_prefix << ".csv and " << output_prefix << ".json" << std::endl;
+
+    return (failed_round_trips > 0) ? 1 : 0;
+}
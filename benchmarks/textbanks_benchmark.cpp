@@ -0,0 +1,68 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../io/io.hpp"
+#include "../tools/huffman_tree.hpp"
+
+/**
+ * Compares the time needed to decode all game strings from a vanilla ROM, using Huffman decoding tables
+ * versus walking Huffman trees one bit at a time, then compares the size of encoded strings when re-encoding them
+ * using median split trees versus optimal trees.
+ *
+ * Usage: textbanks_benchmark <rom_path> [iterations]
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <rom_path> [iterations]" << std::endl;
+        return 1;
+    }
+
+    md::ROM rom(argv[1]);
+    if(!rom.is_valid())
+    {
+        std::cerr << "Could not open ROM '" << argv[1] << "'" << std::endl;
+        return 1;
+    }
+
+    size_t iterations = (argc >= 3) ? std::stoul(argv[2]) : 50;
+
+    std::vector<HuffmanTree*> huffman_trees = io::decode_huffman_trees(rom);
+    std::vector<uint32_t> textbank_addrs = io::read_textbank_addresses(rom);
+
+    auto measure = [&](bool use_decoding_tables, std::vector<std::string>& strings) {
+        auto start = std::chrono::steady_clock::now();
+        for(size_t i=0 ; i<iterations ; ++i)
+            strings = io::decode_textbanks(rom, textbank_addrs, huffman_trees, use_decoding_tables);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / (double)iterations;
+    };
+
+    std::vector<std::string> strings_from_tree_walk, strings_from_tables;
+    double tree_walk_time = measure(false, strings_from_tree_walk);
+    double tables_time = measure(true, strings_from_tables);
+
+    for(HuffmanTree* tree : huffman_trees)
+        delete tree;
+
+    if(strings_from_tree_walk != strings_from_tables)
+    {
+        std::cerr << "Decoding tables and tree walk produce different strings" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Decoded " << strings_from_tables.size() << " strings (" << iterations << " iterations)" << std::endl;
+    std::cout << "Tree walk:       " << tree_walk_time << " us per pass" << std::endl;
+    std::cout << "Decoding tables: " << tables_time << " us per pass" << std::endl;
+    std::cout << "Speedup:         x" << (tree_walk_time / tables_time) << std::endl;
+
+    size_t median_split_size = io::compute_encoded_strings_size(strings_from_tables, false);
+    size_t optimal_size = io::compute_encoded_strings_size(strings_from_tables, true);
+    std::cout << "Encoded strings size (trees + textbanks):" << std::endl;
+    std::cout << "  Median split trees: " << median_split_size << " bytes" << std::endl;
+    std::cout << "  Optimal trees:      " << optimal_size << " bytes ("
+              << ((double)median_split_size - (double)optimal_size) << " bytes saved)" << std::endl;
+    return 0;
+}
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 constexpr size_t SYMBOL_COUNT = 108;
 
 class SymbolCount {
@@ -28,7 +34,7 @@ public:
 
 namespace Symbols 
 {
-    const char TABLE[] = {
+    constexpr char TABLE[SYMBOL_COUNT] = {
         ' ',
         '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
         'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
@@ -63,12 +69,65 @@ namespace Symbols
         '\x6B', // Line break without hyphen in inventory, no space in textboxes
     };
 
+    /**
+     * Builds a table giving the symbol ID for each char, or 0xFF if char has no matching symbol.
+     * When several symbols share the same char, the first one in TABLE is used.
+     */
+    constexpr std::array<uint8_t, 256> build_symbol_for_char_table()
+    {
+        std::array<uint8_t, 256> table {};
+        for(uint8_t& symbol : table)
+            symbol = 0xFF;
+        for(size_t i = SYMBOL_COUNT ; i > 0 ; --i)
+            table[static_cast<uint8_t>(TABLE[i-1])] = static_cast<uint8_t>(i-1);
+        return table;
+    }
+
+    /**
+     * Builds a table giving the char for each symbol ID, with '\0' for IDs past the end of TABLE.
+     */
+    constexpr std::array<char, 256> build_char_for_symbol_table()
+    {
+        std::array<char, 256> table {};
+        for(size_t i = 0 ; i < SYMBOL_COUNT ; ++i)
+            table[i] = TABLE[i];
+        return table;
+    }
+
+    constexpr std::array<uint8_t, 256> SYMBOL_FOR_CHAR = build_symbol_for_char_table();
+    constexpr std::array<char, 256> CHAR_FOR_SYMBOL = build_char_for_symbol_table();
+
+    /**
+     * Checks lookup tables agree with a linear search inside TABLE for every possible char and symbol
+     */
+    constexpr bool lookup_tables_match_symbol_table()
+    {
+        for(size_t c = 0 ; c < 256 ; ++c)
+        {
+            uint8_t expected_symbol = 0xFF;
+            for(size_t i = 0 ; i < SYMBOL_COUNT ; ++i)
+            {
+                if(static_cast<uint8_t>(TABLE[i]) == c)
+                {
+                    expected_symbol = static_cast<uint8_t>(i);
+                    break;
+                }
+            }
+            if(SYMBOL_FOR_CHAR[c] != expected_symbol)
+                return false;
+        }
+
+        for(size_t i = 0 ; i < 256 ; ++i)
+            if(CHAR_FOR_SYMBOL[i] != ((i < SYMBOL_COUNT) ? TABLE[i] : '\0'))
+                return false;
+
+        return true;
+    }
+    static_assert(lookup_tables_match_symbol_table(), "Symbol lookup tables do not match symbol table");
+
     inline uint8_t byte_for_symbol(char symbol)
     {
-        for(uint8_t i=0 ; i<SYMBOL_COUNT ; ++i)
-            if(TABLE[i] == symbol)
-                return i;
-        return 0xFF;
+        return SYMBOL_FOR_CHAR[static_cast<uint8_t>(symbol)];
     }
 
     inline std::vector<uint8_t> bytes_for_symbols(const std::string& symbol_string)
@@ -94,7 +153,7 @@ namespace Symbols
             else if(byte == 0x6A)
                 ret += ' ';
             else
-                ret += TABLE[byte];
+                ret += CHAR_FOR_SYMBOL[byte];
         }
 
         return ret;
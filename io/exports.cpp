@@ -52,7 +52,7 @@ void io::export_game_strings_as_json(const World& world, const std::string& file
     {
         std::stringstream hex_id;
         hex_id << "0x" << std::hex << i;
-        strings_json[hex_id.str()] = world.game_strings()[i];
+        strings_json[hex_id.str()] = std::string(world.game_strings()[i]);
     }
     dump_json_to_file(strings_json, file_path);
 }
@@ -1,14 +1,72 @@
 #pragma once
 
 #include "../md_tools.hpp"
+#include "../tools/json.hpp"
+
+#include <set>
+#include <string>
 
 class Blockset;
 class World;
 class ByteArray;
 class HuffmanTree;
 class MapLayout;
+struct TextbanksEncodingCache;
+class StringPool;
+template<size_t N> class ColorPalette;
 
 namespace io {
+    /**
+     * Options altering how a World gets read from a ROM
+     */
+    struct WorldReadOptions {
+        /// Only decode game strings when they are first accessed instead of decoding all of them while reading the ROM
+        bool lazy_game_strings = false;
+    };
+
+    /**
+     * Options altering how a World gets written inside a ROM
+     */
+    struct WorldWriteOptions {
+        /// Build textbank Huffman trees using an optimal length-limited construction instead of median splits
+        bool optimal_huffman_trees = false;
+        /// Maximum number of threads used for parallelizable tasks such as textbanks and map layouts encoding
+        /// (0 means as many as the hardware supports, 1 means everything is done in the calling thread)
+        size_t thread_count = 0;
+        /// Relative symbol statistics drift since textbank trees were last built above which trees get rebuilt,
+        /// instead of only re-encoding changed strings with the current trees
+        double textbanks_rebuild_drift_threshold = 0.05;
+        /// Path of a file used to keep encoded map layouts from one write to the next (no cache is used if empty)
+        std::string map_layouts_cache_path;
+        /// Store layouts of map variants which only differ from the layout of their parent map by a few tiles as
+        /// a list of tile patches to apply on top of it, when that takes less space than the full layout
+        bool map_layouts_variant_deltas = false;
+    };
+
+    /**
+     * Statistics about a World being written inside a ROM
+     */
+    struct WorldWriteReport {
+        /// Number of map layouts which were identical to a previous one, and were made to share its data
+        size_t shared_map_layouts = 0;
+        /// Number of bytes which would have been taken by shared map layouts if they were written separately
+        size_t map_layouts_bytes_saved = 0;
+        /// Number of map variant layouts which were stored as patches to apply on top of their parent map layout
+        size_t delta_map_layouts = 0;
+        /// Number of bytes saved by storing those layouts as patches instead of full layouts
+        size_t map_layouts_delta_bytes_saved = 0;
+
+        [[nodiscard]] Json to_json() const
+        {
+            Json json;
+            json["sharedMapLayouts"] = shared_map_layouts;
+            json["mapLayoutsBytesSaved"] = map_layouts_bytes_saved;
+            json["deltaMapLayouts"] = delta_map_layouts;
+            json["mapLayoutsDeltaBytesSaved"] = map_layouts_delta_bytes_saved;
+            return json;
+        }
+    };
+
     // blocksets_decoder.cpp
     Blockset* decode_blockset(const md::ROM& rom, uint32_t addr);
     // blocksets_encoder.cpp
@@ -16,18 +74,51 @@ namespace io {
 
     // map_layout_decoder.cpp
     MapLayout* decode_map_layout(const md::ROM& rom, uint32_t addr);
+    // map_layout_new_decoder.cpp
+    /// Decodes a single layout in the format loaded by PatchNewMapFormat (including incrementing runs and delta
+    /// layouts). Since trailing default values are not encoded, layout and heightmap heights are the smallest ones
+    /// holding all encoded data.
+    /// This only covers layouts: read_world_from_rom cannot read ROMs written by write_world_to_rom, since the
+    /// writer relocates many other tables (palettes, blocksets, entities, dialogues...) that it reads at vanilla offsets.
+    MapLayout* decode_map_layout_new(const md::ROM& rom, uint32_t addr);
     // map_layout_encoder.cpp
-    ByteArray encode_map_layout(MapLayout* map_layout);
+    /// Encodes a layout in the format loaded by the vanilla game
+    ByteArray encode_map_layout_old(MapLayout* map_layout);
+    // map_layout_new_encoder.cpp
+    /// Encodes a layout in the format loaded by PatchNewMapFormat. Incrementing runs can only be used if the patch
+    /// was built with incrementing runs support.
+    ByteArray encode_map_layout(MapLayout* map_layout, bool incrementing_runs = false);
+    /// Encodes a layout as a list of tile patches to apply on top of another layout stored at `base_layout_addr`,
+    /// which must have been encoded as a full layout. Both layouts must share the same position and sizes.
+    bool can_encode_map_layout_delta(MapLayout* map_layout, MapLayout* base_layout);
+    ByteArray encode_map_layout_delta(MapLayout* map_layout, MapLayout* base_layout, uint32_t base_layout_addr);
 
     // textbanks_decoder.cpp
     HuffmanTree* decode_huffman_tree(const md::ROM& rom, uint32_t addr);
-    std::vector<std::string> decode_textbanks(const md::ROM& rom, const std::vector<uint32_t>& addrs, const std::vector<HuffmanTree*>& huffman_trees);
+    std::vector<HuffmanTree*> decode_huffman_trees(const md::ROM& rom);
+    std::vector<uint32_t> read_textbank_addresses(const md::ROM& rom);
+    std::vector<std::string> decode_textbanks(const md::ROM& rom, const std::vector<uint32_t>& addrs,
+                                              const std::vector<HuffmanTree*>& huffman_trees, bool use_decoding_tables = true);
+    std::string decode_encoded_string(const ByteArray& encoded_string, const std::vector<HuffmanTree*>& huffman_trees);
+    std::vector<ByteArray> read_encoded_strings(const md::ROM& rom, const std::vector<uint32_t>& addrs);
     // textbanks_encoder.cpp
-    std::vector<HuffmanTree*> build_trees_from_strings(const std::vector<std::string>& strings);
+    std::vector<HuffmanTree*> build_trees_from_strings(const std::vector<std::string>& strings, bool optimal_trees = false,
+                                                       size_t thread_count = 0);
     void encode_huffman_trees(const std::vector<HuffmanTree*>& huffman_trees,
                               ByteArray& tree_offsets,
                               ByteArray& tree_data);
-    std::vector<ByteArray> encode_textbanks(const std::vector<std::string>& strings, const std::vector<HuffmanTree*>& huffman_trees);
+    std::vector<ByteArray> encode_textbanks(const std::vector<std::string>& strings, const std::vector<HuffmanTree*>& huffman_trees,
+                                            size_t thread_count = 0);
+    void init_textbanks_encoding_cache(TextbanksEncodingCache& cache, const StringPool& strings,
+                                       const std::vector<HuffmanTree*>& huffman_trees,
+                                       const std::vector<ByteArray>& encoded_strings);
+    /// `decoded_strings` tells for each string if its text is in `strings` (empty if all are). Strings which are not
+    /// were read lazily and never accessed since, so they are known to be the ones already encoded in the cache.
+    void encode_textbanks_incrementally(const StringPool& strings, const std::vector<bool>& decoded_strings,
+                                        const std::set<uint16_t>* changed_string_ids,
+                                        TextbanksEncodingCache& cache,
+                                        bool optimal_trees, double max_statistics_drift, size_t thread_count = 0);
+    size_t compute_encoded_strings_size(const std::vector<std::string>& strings, bool optimal_trees);
 
     // exports.cpp
     void export_item_sources_as_json(const World& world, const std::string& file_path);
@@ -38,8 +129,18 @@ namespace io {
     void export_map_palettes_as_json(const World& world, const std::string& file_path);
     void export_game_strings_as_json(const World& world, const std::string& file_path);
 
+    // sprites_exporter.cpp
+    std::vector<std::vector<uint32_t>> read_sprite_frame_addresses(const md::ROM& rom, uint32_t sprite_table_addr);
+    void export_sprites_as_png_atlases(const md::ROM& rom,
+                                       const std::vector<std::vector<uint32_t>>& sprite_frame_addresses,
+                                       const std::vector<ColorPalette<16>>& palettes,
+                                       const std::vector<size_t>& sprite_palette_ids,
+                                       const std::string& output_directory,
+                                       uint16_t atlas_size = 1024,
+                                       size_t thread_count = 0);
+
     // world_rom_reader.cpp
-    void read_world_from_rom(const md::ROM& rom, World& world);
+    void read_world_from_rom(const md::ROM& rom, World& world, const WorldReadOptions& options = {});
     // world_rom_writer.cpp
-    void write_world_to_rom(World& world, md::ROM& rom);
+    WorldWriteReport write_world_to_rom(World& world, md::ROM& rom, const WorldWriteOptions& options = {});
 }
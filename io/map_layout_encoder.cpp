@@ -5,6 +5,7 @@
 #include "../model/map_layout.hpp"
 
 #include <array>
+#include <cstdint>
 #include <map>
 #include <algorithm>
 
@@ -27,7 +28,37 @@ static uint8_t count_bits(uint16_t num)
     return exp;
 }
 
+/**
+ * For each offset of the dictionary, the number of consecutive tiles that can be repeated using this offset
+ * starting from each address (0 if the tile at this address cannot be repeated using this offset)
+ */
+using OffsetRunLengths = std::vector<std::vector<uint32_t>>;
+
+static std::vector<uint32_t> compute_run_lengths(uint16_t offset, const std::vector<uint16_t>& tile_values)
+{
+    // Computed backwards, since a run starting at an address is one tile longer than the one starting right after
+    std::vector<uint32_t> run_lengths(tile_values.size() + 1, 0);
+    if(offset == 0x0000 || offset == 0xFFFF)
+        return run_lengths;
+
+    for(size_t addr = tile_values.size() ; addr-- > offset ; )
+        if(tile_values[addr - offset] == tile_values[addr])
+            run_lengths[addr] = run_lengths[addr + 1] + 1;
+    return run_lengths;
+}
+
+/**
+ * Computes run lengths for offsets which were added to the dictionary since last call
+ */
+static void update_run_lengths(OffsetRunLengths& run_lengths, const std::vector<uint16_t>& offset_dictionary,
+                               const std::vector<uint16_t>& tile_values)
+{
+    for(size_t offset_id = run_lengths.size() ; offset_id < offset_dictionary.size() ; ++offset_id)
+        run_lengths.emplace_back(compute_run_lengths(offset_dictionary[offset_id], tile_values));
+}
+
 static std::vector<uint8_t> assign_best_offsets_from_dictionary(const std::vector<uint16_t>& offset_dictionary,
+                                                                const OffsetRunLengths& run_lengths,
                                                                 const std::vector<uint16_t>& tile_values)
 {
     std::vector<uint8_t> offset_dictionary_ids;
@@ -60,33 +91,15 @@ static std::vector<uint8_t> assign_best_offsets_from_dictionary(const std::vecto
         if(offset_dictionary_ids[addr])
             continue;
 
-        // Then test all offsets from the dictionary, and evaluate for how many tiles they can be repeated
-        std::array<size_t, 14> sequence_length_for_id { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-        for(size_t offset_id = 1 ; offset_id < offset_dictionary.size() ; ++offset_id)
-        {
-            uint16_t offset = offset_dictionary[offset_id];
-            if(offset == 0x0000 || offset > addr)
-                continue;
-            if(tile_values[addr - offset] != tile_values[addr])
-                continue;
-
-            sequence_length_for_id[offset_id] += 1;
-            for(size_t next_addr = addr + 1 ; next_addr < tile_values.size() ; ++next_addr)
-            {
-                if(tile_values[next_addr] != tile_values[next_addr - offset])
-                    break;
-                sequence_length_for_id[offset_id] += 1;
-            }
-        }
-
-        // Return the best offset ID (the one to provide the longest repeat sequence)
+        // Then test all offsets from the dictionary, and take the best one (the one to provide the longest repeat
+        // sequence, which was precomputed for each offset)
         size_t longest_sequence = 0;
         uint8_t best_offset_id = 0;
         for(size_t offset_id = 1 ; offset_id < offset_dictionary.size() ; ++offset_id)
         {
-            if(sequence_length_for_id[offset_id] > longest_sequence)
+            if(run_lengths[offset_id][addr] > longest_sequence)
             {
-                longest_sequence = sequence_length_for_id[offset_id];
+                longest_sequence = run_lengths[offset_id][addr];
                 best_offset_id = offset_id;
             }
         }
@@ -97,6 +110,93 @@ static std::vector<uint8_t> assign_best_offsets_from_dictionary(const std::vecto
     return offset_dictionary_ids;
 }
 
+/**
+ * Dynamic offsets are stored on 12 bits in the dictionary, which bounds how far back an offset can look
+ */
+constexpr uint16_t MAX_DYNAMIC_OFFSET = 0xFFF;
+
+/**
+ * Scores of candidate dynamic offsets, each score being the number of uncovered tiles which would get covered
+ * if this offset was added to the dictionary.
+ */
+class OffsetScores
+{
+private:
+    const std::vector<uint16_t>& _tile_values;
+    /// Addresses sorted by tile value then by address, so that addresses sharing the value of a tile are contiguous
+    std::vector<uint32_t> _addresses_by_value;
+    /// Position of each address inside _addresses_by_value
+    std::vector<uint32_t> _positions;
+    std::array<uint32_t, MAX_DYNAMIC_OFFSET + 1> _scores {};
+
+public:
+    explicit OffsetScores(const std::vector<uint16_t>& tile_values) : _tile_values(tile_values)
+    {
+        _addresses_by_value.resize(tile_values.size());
+        for(uint32_t addr = 0 ; addr < tile_values.size() ; ++addr)
+            _addresses_by_value[addr] = addr;
+        std::stable_sort(_addresses_by_value.begin(), _addresses_by_value.end(), [&tile_values](uint32_t a, uint32_t b) {
+            return tile_values[a] < tile_values[b];
+        });
+
+        _positions.resize(tile_values.size());
+        for(uint32_t i = 0 ; i < _addresses_by_value.size() ; ++i)
+            _positions[_addresses_by_value[i]] = i;
+    }
+
+    /**
+     * Adds (or removes) the contribution of the tile at `addr` to the score of every offset that could cover it
+     */
+    void update(size_t addr, int32_t delta)
+    {
+        uint16_t value = _tile_values[addr];
+        for(size_t i = _positions[addr] ; i-- > 0 ; )
+        {
+            uint32_t prev_addr = _addresses_by_value[i];
+            if(_tile_values[prev_addr] != value || addr - prev_addr > MAX_DYNAMIC_OFFSET)
+                break;
+            _scores[addr - prev_addr] += delta;
+        }
+    }
+
+    /**
+     * @return the offset with the best score. On ties, the chosen offset is the one which would have reached this
+     *         score first by scoring tiles in ascending address order (which is how offsets used to be chosen):
+     *         the one with the lowest last covered address, then the biggest offset.
+     */
+    [[nodiscard]] uint16_t best_offset(const std::vector<bool>& covered_tiles) const
+    {
+        uint32_t best_score = *std::max_element(_scores.begin(), _scores.end());
+        if(best_score == 0)
+            return 0;
+
+        uint16_t best_offset = 0;
+        size_t best_last_addr = SIZE_MAX;
+        for(uint16_t offset = MAX_DYNAMIC_OFFSET ; offset > 0 ; --offset)
+        {
+            if(_scores[offset] != best_score)
+                continue;
+
+            size_t last_addr = this->last_covered_address(offset, covered_tiles);
+            if(last_addr < best_last_addr)
+            {
+                best_offset = offset;
+                best_last_addr = last_addr;
+            }
+        }
+        return best_offset;
+    }
+
+private:
+    [[nodiscard]] size_t last_covered_address(uint16_t offset, const std::vector<bool>& covered_tiles) const
+    {
+        for(size_t addr = _tile_values.size() ; addr-- > offset ; )
+            if(!covered_tiles[addr] && _tile_values[addr - offset] == _tile_values[addr])
+                return addr;
+        return SIZE_MAX;
+    }
+};
+
 static std::vector<uint8_t> deduce_offsets(const std::vector<uint16_t>& tile_values,
                                                  std::vector<uint16_t>& offset_dictionary)
 {
@@ -115,51 +215,35 @@ static std::vector<uint8_t> deduce_offsets(const std::vector<uint16_t>& tile_val
     // We then add this new offset to the dictionary, assign the newly covered tiles, and perform another step to
     // cover yet some more holes where data has to be read directly.
 
-    // Prepare a map that list all adresses for a given value, for quick lookup
-    std::map<uint16_t, std::vector<size_t>> value_addresses;
-    for(size_t i=0 ; i<tile_values.size() ; ++i)
-        value_addresses[tile_values[i]].emplace_back(i);
+    // Scores only change for tiles which got covered (or uncovered) since previous step, so they are kept from one
+    // step to the next and only updated for those tiles
+    OffsetScores offset_scores(tile_values);
+    std::vector<bool> covered_tiles(tile_values.size(), true);
 
+    // Run lengths only need to be computed once for each offset, then for each offset added to the dictionary
+    OffsetRunLengths run_lengths;
     while(offset_dictionary.size() < 14)
     {
-        std::vector<uint8_t> offset_dictionary_ids = assign_best_offsets_from_dictionary(offset_dictionary, tile_values);
+        update_run_lengths(run_lengths, offset_dictionary, tile_values);
+        std::vector<uint8_t> offset_dictionary_ids = assign_best_offsets_from_dictionary(offset_dictionary, run_lengths,
+                                                                                         tile_values);
 
         // There is still room for new offsets in the dictionary, try to find the best one to add
-        //std::map<uint16_t, size_t> offset_scores;
-        std::vector<size_t> offset_scores;
-        offset_scores.resize(0x10000, 0);
-
-        // Assign scores to offsets
-        uint16_t best_offset = 0;
-        size_t best_score = 0;
         for(size_t addr=0 ; addr < tile_values.size() ; ++addr)
         {
-            // Ignore already assigned values
-            if(offset_dictionary_ids[addr] != 0)
-                continue;
-
-            uint16_t value = tile_values[addr];
-            for(size_t prev_addr : value_addresses.at(value))
+            bool covered = (offset_dictionary_ids[addr] != 0);
+            if(covered != covered_tiles[addr])
             {
-                size_t offset = addr - prev_addr;
-                if(prev_addr < addr && offset <= 0xFFFE)
-                {
-                    size_t& score = offset_scores[offset];
-                    score += 1;
-                    // Keep track of the offset with the best score
-                    if(score > best_score)
-                    {
-                        best_offset = offset;
-                        best_score = score;
-                    }
-                }
+                offset_scores.update(addr, covered ? -1 : 1);
+                covered_tiles[addr] = covered;
             }
         }
 
-        offset_dictionary.emplace_back(best_offset);
+        offset_dictionary.emplace_back(offset_scores.best_offset(covered_tiles));
     }
 
-    return assign_best_offsets_from_dictionary(offset_dictionary, tile_values);
+    update_run_lengths(run_lengths, offset_dictionary, tile_values);
+    return assign_best_offsets_from_dictionary(offset_dictionary, run_lengths, tile_values);
 }
 
 static void encode_tile_values(const std::vector<uint16_t>& tile_values_written_to_rom,
@@ -525,7 +609,7 @@ static void encode_heightmap(const std::vector<uint16_t>& heightmap_data, Bitstr
     }
 }
 
-ByteArray encode_map_layout_old(MapLayout* map_layout)
+ByteArray io::encode_map_layout_old(MapLayout* map_layout)
 {
     // -----------------------------------------------
     //      Setup phase
@@ -0,0 +1,212 @@
+#include "io.hpp"
+#include "../model/map_layout.hpp"
+#include "../exceptions.hpp"
+
+/// Maximum amount of words a data block can describe, since the loader places them in a buffer of 74x74 words
+static constexpr size_t MAX_DATA_BLOCK_SIZE = 74 * 74;
+
+/**
+ * Decodes a data block the same way the loader injected by PatchNewMapFormat does, up to its end of block command.
+ * Since trailing default values are not encoded, the returned block can be shorter than the one which was encoded.
+ */
+static std::vector<uint16_t> decode_data_block(const md::ROM& rom, uint32_t& addr, uint16_t default_value)
+{
+    std::vector<uint16_t> words;
+
+    auto read_word = [&rom, &addr]() -> uint16_t {
+        if(addr + 2 > rom.size())
+            throw LandstalkerException("Map layout data goes past the end of the ROM");
+        uint16_t word = rom.get_word(addr);
+        addr += 2;
+        return word;
+    };
+
+    auto place_words = [&words](uint16_t value, size_t count, uint16_t increment = 0) {
+        if(words.size() + count > MAX_DATA_BLOCK_SIZE)
+            throw LandstalkerException("Map layout data block does not fit in the map buffer");
+        for(size_t i=0 ; i<count ; ++i)
+        {
+            words.emplace_back(value);
+            value += increment;
+        }
+    };
+
+    // The loader decrements its counters before checking them, so a count of 0 means 0x10000
+    auto loader_count = [](uint16_t count) -> size_t { return (count == 0) ? 0x10000 : count; };
+
+    while(true)
+    {
+        uint16_t word = read_word();
+        if(!(word & 0x8000))
+        {
+            // "0WWWWWWW WWWWWWWW": place word W
+            place_words(word, 1);
+            continue;
+        }
+
+        word &= 0x7FFF;
+        if(word == 0)
+            break; // "10000000 00000000": end of block
+
+        uint16_t data = word & 0x0FFF;
+        switch(word >> 12)
+        {
+            case 0: // "1000AAAA AAAAAAAA": skip A words
+                place_words(default_value, loader_count(data));
+                break;
+            case 1: // "1001AAAA AABBBBBB": place byte A then byte B as words
+                place_words(data >> 6, 1);
+                place_words(data & 0x3F, 1);
+                break;
+            case 2: // "1010AAAA BBBBBBBB": repeat A times byte B
+                place_words(data & 0xFF, loader_count(data >> 8));
+                break;
+            case 4: // "1100WWWW WWWWWWXX": place word W 2+X times, incrementing it on every write
+                place_words(data >> 2, (data & 0x3) + 2, 1);
+                break;
+            case 5: // "1101BBBB BBBBAAAA": repeat A+2 times byte B as an inverted word (0x26 >>> 0x2600)
+                place_words((data << 4) & 0xFF00, (data & 0xF) + 2);
+                break;
+            case 6: // "1110WWWW WWWWWWXX": repeat 2+X times word W
+                place_words(data >> 2, (data & 0x3) + 2);
+                break;
+            default: // "1011AAAA AAAAAAAA": repeat next word A times (also taken by the loader for unused 1111)
+                place_words(read_word(), loader_count(data));
+                break;
+        }
+    }
+
+    return words;
+}
+
+/// Size of a line inside the map buffers filled by the loader
+static constexpr uint16_t LINE_SIZE_IN_BYTES = 74 * 2;
+
+/**
+ * Header and data blocks (foreground tiles, background tiles, heightmap) of a layout in the new format
+ */
+struct NewFormatLayoutData {
+    uint8_t top = 0;
+    uint8_t left = 0;
+    uint8_t width = 0;
+    uint8_t heightmap_width = 0;
+    std::vector<uint16_t> foreground_tiles;
+    std::vector<uint16_t> background_tiles;
+    std::vector<uint16_t> heightmap;
+};
+
+static NewFormatLayoutData decode_full_layout(const md::ROM& rom, uint32_t addr)
+{
+    if(addr + 4 > rom.size())
+        throw LandstalkerException("Map layout data goes past the end of the ROM");
+
+    NewFormatLayoutData data;
+    data.top = rom.get_byte(addr);
+    data.left = rom.get_byte(addr + 1);
+    data.width = rom.get_byte(addr + 2);
+    data.heightmap_width = rom.get_byte(addr + 3);
+    addr += 4;
+
+    data.foreground_tiles = decode_data_block(rom, addr, 0x0000);
+    data.background_tiles = decode_data_block(rom, addr, 0x0000);
+    data.heightmap = decode_data_block(rom, addr, 0x4000);
+    return data;
+}
+
+/**
+ * Applies (buffer offset, value) patches from a delta layout on a block, up to the 0xFFFF terminator
+ * @param origin the offset in bytes from the start of the map buffer to the first word of the block
+ */
+static void apply_delta_patches(const md::ROM& rom, uint32_t& addr, std::vector<uint16_t>& block,
+                                uint16_t default_value, uint16_t origin, uint8_t width)
+{
+    while(true)
+    {
+        if(addr + 2 > rom.size())
+            throw LandstalkerException("Map layout data goes past the end of the ROM");
+        uint16_t offset = rom.get_word(addr);
+        addr += 2;
+        if(offset & 0x8000)
+            break;
+
+        if(addr + 2 > rom.size())
+            throw LandstalkerException("Map layout data goes past the end of the ROM");
+        uint16_t value = rom.get_word(addr);
+        addr += 2;
+
+        uint16_t line = (offset - origin) / LINE_SIZE_IN_BYTES;
+        uint16_t column = ((offset - origin) % LINE_SIZE_IN_BYTES) / 2;
+        if(offset < origin || (offset & 1) || column >= width)
+            throw LandstalkerException("Map layout delta patches a word outside of the layout");
+
+        size_t i = (line * width) + column;
+        if(i >= MAX_DATA_BLOCK_SIZE)
+            throw LandstalkerException("Map layout data block does not fit in the map buffer");
+        if(i >= block.size())
+            block.resize(i + 1, default_value);
+        block[i] = value;
+    }
+}
+
+/**
+ * @return the smallest amount of lines of `width` words needed to hold all words of `block` which are not
+ *         trailing default values
+ */
+static uint8_t line_count(const std::vector<uint16_t>& block, uint8_t width, uint16_t default_value)
+{
+    size_t size = block.size();
+    while(size > 0 && block[size - 1] == default_value)
+        --size;
+
+    if(size == 0)
+        return 0;
+    if(width == 0)
+        throw LandstalkerException("Map layout has data but a width of 0");
+
+    size_t lines = (size + width - 1) / width;
+    if(lines > 0xFF)
+        throw LandstalkerException("Map layout is too high");
+    return (uint8_t)lines;
+}
+
+MapLayout* io::decode_map_layout_new(const md::ROM& rom, uint32_t addr)
+{
+    if(addr + 6 > rom.size())
+        throw LandstalkerException("Map layout data goes past the end of the ROM");
+
+    NewFormatLayoutData data;
+    if(rom.get_byte(addr) == 0xFF)
+    {
+        // Delta layout: base layout address followed by patches for each block
+        uint32_t base_layout_addr = rom.get_long(addr + 2);
+        if(base_layout_addr + 1 > rom.size() || rom.get_byte(base_layout_addr) == 0xFF)
+            throw LandstalkerException("Map layout delta must be based on a full layout");
+        data = decode_full_layout(rom, base_layout_addr);
+        addr += 6;
+
+        uint16_t tiles_origin = (data.top * LINE_SIZE_IN_BYTES) + (data.left * 2);
+        apply_delta_patches(rom, addr, data.foreground_tiles, 0x0000, tiles_origin, data.width);
+        apply_delta_patches(rom, addr, data.background_tiles, 0x0000, tiles_origin, data.width);
+
+        // Heightmap is always placed at line 12, column 12
+        uint16_t heightmap_origin = (0xC * LINE_SIZE_IN_BYTES) + (0xC * 2);
+        apply_delta_patches(rom, addr, data.heightmap, 0x4000, heightmap_origin, data.heightmap_width);
+    }
+    else data = decode_full_layout(rom, addr);
+
+    // Heights are not stored in this format, since trailing default values are not encoded. Use the smallest heights
+    // holding all encoded values, which encode back to the same data.
+    uint8_t height = std::max(line_count(data.foreground_tiles, data.width, 0x0000),
+                              line_count(data.background_tiles, data.width, 0x0000));
+    uint8_t heightmap_height = line_count(data.heightmap, data.heightmap_width, 0x4000);
+
+    data.foreground_tiles.resize(data.width * height, 0x0000);
+    data.background_tiles.resize(data.width * height, 0x0000);
+    data.heightmap.resize(data.heightmap_width * heightmap_height, 0x4000);
+
+    MapLayout* map_layout = new MapLayout(data.left, data.top, data.width, height);
+    map_layout->foreground_tiles(data.foreground_tiles);
+    map_layout->background_tiles(data.background_tiles);
+    map_layout->heightmap(data.heightmap, { data.heightmap_width, heightmap_height });
+    return map_layout;
+}
@@ -1,135 +1,159 @@
 #include "io.hpp"
 #include "../tools/byte_array.hpp"
 #include "../model/map_layout.hpp"
-
-static ByteArray encode_data_block(const std::vector<uint16_t>& data_block, uint16_t default_value)
+#include "../exceptions.hpp"
+
+#include <deque>
+
+/// Maximum repeat count for "skip" and "repeat next word" commands, which store it on 12 bits
+static constexpr uint16_t MAX_LONG_REPEAT_COUNT = 0x0FFF;
+
+/**
+ * Commands of the new map format, as handled by the loader injected by PatchNewMapFormat
+ */
+enum class DataBlockCommand : uint8_t {
+    RAW_WORD,               // "0WWWWWWW WWWWWWWW": place word W
+    PACKED_BYTES,           // "1001AAAA AABBBBBB": place byte A then byte B as words
+    SKIP,                   // "1000AAAA AAAAAAAA": skip A words (leaving the default value)
+    REPEAT_BYTE,            // "1010AAAA BBBBBBBB": repeat A times byte B
+    REPEAT_WORD,            // "1011AAAA AAAAAAAA": repeat next word A times
+    REPEAT_INVERTED_WORD,   // "1101BBBB BBBBAAAA": repeat A+2 times byte B as an inverted word (0x26 >>> 0x2600)
+    REPEAT_SMALL_WORD,      // "1110WWWW WWWWWWXX": repeat 2+X times word W
+    INCREMENTING_RUN        // "1100WWWW WWWWWWXX": place word W 2+X times, incrementing it on every write
+};
+
+struct DataBlockStep {
+    /// Size in words of the cheapest encoding of the data from this position to the end of the block
+    uint32_t cost = UINT32_MAX;
+    DataBlockCommand command = DataBlockCommand::RAW_WORD;
+    /// Number of data words covered by the command
+    uint16_t length = 1;
+};
+
+/**
+ * Finds the smallest sequence of commands describing a data block, using dynamic programming over positions from
+ * the end of the block: the cheapest encoding starting at a position is the cheapest combination of a command
+ * starting there and of the cheapest encoding for the position following it.
+ */
+static std::vector<DataBlockStep> find_cheapest_commands(const std::vector<uint16_t>& values, size_t count,
+                                                         uint16_t default_value, bool incrementing_runs)
 {
-    // Remove trailing default values
-    std::vector<uint16_t> tile_values = data_block;
-    while(!tile_values.empty() && *tile_values.rbegin() == default_value)
-        tile_values.pop_back();
+    std::vector<DataBlockStep> steps(count + 1);
+    steps[count].cost = 0;
+
+    // Positions reachable by a long command (skip or "repeat next word") are all the ones from i+1 to the end of the
+    // run of equal values, capped by the max count. They are kept in a sliding window minimum: costs increase from
+    // back to front, and the back is dropped once it goes out of reach.
+    std::deque<size_t> long_command_targets;
+    size_t run_end = count;
+
+    auto try_command = [&](size_t i, DataBlockCommand command, uint16_t length, uint32_t command_cost) {
+        uint32_t cost = command_cost + steps[i + length].cost;
+        if(cost < steps[i].cost)
+            steps[i] = { cost, command, length };
+    };
 
-    ByteArray bytes;
-    uint32_t current_chain_size = 0;
-    uint16_t current_chain_word = 0x0000;
-    auto output_chain = [&]()
+    for(size_t i = count ; i-- > 0 ; )
     {
-        while(current_chain_size > 1)
-        {
-            if(current_chain_word == default_value)
-            {
-                // 0 -> "1000AAAA AAAAAAAA" case: skip A words
-                uint16_t effective_size = std::min(current_chain_size, (uint32_t)0x0FFF);
-                bytes.add_word(0x8000 + effective_size);
-                current_chain_size -= effective_size;
-            }
-            else if(current_chain_word <= 0x00FF)
-            {
-                // 2 -> "1010AAAA BBBBBBBB" case: repeat A times byte B
-                uint16_t effective_size = std::min(current_chain_size, (uint32_t)0x000F);
-                bytes.add_word(0xA000 + (effective_size << 8) + current_chain_word);
-                current_chain_size -= effective_size;
-            }
-            else if((current_chain_word & 0xFF00) == current_chain_word)
-            {
-                // 5 -> "1101BBBB BBBBAAAA" case: repeat A+2 times byte B as an inverted word (0x26 >>> 0x2600)
-                uint16_t effective_size = std::min(current_chain_size, (uint32_t)17);
-                bytes.add_word(0xD000 + (current_chain_word >> 4) + (effective_size - 2));
-                current_chain_size -= effective_size;
-            }
-            else if(current_chain_word <= 0x3FF)
-            {
-                // 6 -> "1110WWWW WWWWWWXX" case: repeat 2+X times word W
-                uint16_t effective_size = std::min(current_chain_size, (uint32_t)5);
-                bytes.add_word(0xE000 + (current_chain_word << 2) + (effective_size - 2));
-                current_chain_size -= effective_size;
-            }
-            else if(current_chain_size > 2)
-            {
-                // 3 -> "1011AAAA AAAAAAAA" case: repeat next word A times
-                uint16_t effective_size = std::min(current_chain_size, (uint32_t)0x0FFF);
-                bytes.add_word(0xB000 + effective_size);
-                bytes.add_word(current_chain_word);
-                current_chain_size -= effective_size;
-            }
-            else break;
-
-            // 4, 7 are free
-            // 1100, 1111
-        }
-
-        while(current_chain_size > 0)
+        uint16_t value = values[i];
+        if(i + 1 == count || values[i + 1] != value)
         {
-            bytes.add_word(current_chain_word);
-            current_chain_size--;
+            run_end = i + 1;
+            long_command_targets.clear();
         }
-    };
-
-    for(uint16_t tile : tile_values)
-    {
-        if(tile == current_chain_word && current_chain_size > 0)
+        size_t run_length = run_end - i;
+
+        if(value < 0x8000)
+            try_command(i, DataBlockCommand::RAW_WORD, 1, 1);
+        if(i + 1 < count && value <= 0x3F && values[i + 1] <= 0x3F)
+            try_command(i, DataBlockCommand::PACKED_BYTES, 2, 1);
+
+        while(!long_command_targets.empty() && steps[long_command_targets.front()].cost >= steps[i + 1].cost)
+            long_command_targets.pop_front();
+        long_command_targets.push_front(i + 1);
+        while(long_command_targets.back() > i + MAX_LONG_REPEAT_COUNT)
+            long_command_targets.pop_back();
+        uint16_t long_command_length = long_command_targets.back() - i;
+        if(value == default_value)
+            try_command(i, DataBlockCommand::SKIP, long_command_length, 1);
+        else
+            try_command(i, DataBlockCommand::REPEAT_WORD, long_command_length, 2);
+
+        if(value <= 0x00FF)
+            for(uint16_t length = 2 ; length <= std::min<size_t>(run_length, 0x0F) ; ++length)
+                try_command(i, DataBlockCommand::REPEAT_BYTE, length, 1);
+        if((value & 0xFF00) == value)
+            for(uint16_t length = 2 ; length <= std::min<size_t>(run_length, 17) ; ++length)
+                try_command(i, DataBlockCommand::REPEAT_INVERTED_WORD, length, 1);
+        if(value <= 0x3FF)
+            for(uint16_t length = 2 ; length <= std::min<size_t>(run_length, 5) ; ++length)
+                try_command(i, DataBlockCommand::REPEAT_SMALL_WORD, length, 1);
+
+        if(incrementing_runs && value <= 0x3FF)
         {
-            current_chain_size++;
-            continue;
+            for(uint16_t length = 2 ; length <= 5 && i + length <= count ; ++length)
+            {
+                if(values[i + length - 1] != value + length - 1)
+                    break;
+                try_command(i, DataBlockCommand::INCREMENTING_RUN, length, 1);
+            }
         }
-
-        output_chain();
-        current_chain_word = tile;
-        current_chain_size = 1;
     }
 
-    output_chain();
-    bytes.add_word(0x8000);
-
-    // =========== Post processing ==============
-    // Pack successive increasing values, etc...
+    return steps;
+}
 
-    uint16_t last_word;
-    uint16_t current_word = bytes.word_at(0);
-    for(size_t i=2 ; i<bytes.size() ; i+=2)
-    {
-        last_word = current_word;
-        current_word = bytes.word_at(i);
+static ByteArray encode_data_block(const std::vector<uint16_t>& data_block, uint16_t default_value, bool incrementing_runs)
+{
+    // Remove trailing default values
+    size_t tile_count = data_block.size();
+    while(tile_count > 0 && data_block[tile_count - 1] == default_value)
+        --tile_count;
 
-        bool is_last_word_operand = (last_word & 0x8000);
-        bool is_current_word_operand = (current_word & 0x8000);
-        if(is_current_word_operand || is_last_word_operand)
-            continue;
+    std::vector<DataBlockStep> steps = find_cheapest_commands(data_block, tile_count, default_value, incrementing_runs);
 
-/*        if(current_word == last_word + 1 && last_word <= 0x3FF)
-        {
-            // "1100WWWW WWWWWWXX" case: repeat word W 2+X times while incrementing value on every write
-            size_t x = 0;
-            size_t forward_cursor = i+2;
-            while(forward_cursor < bytes.size() && x < 3)
-            {
-                uint16_t next_byte = bytes.word_at(forward_cursor);
-                if(next_byte & 0x8000)
-                    break;
-                if(next_byte != current_word + 1 + x)
-                    break;
-                ++x;
-                bytes.remove_word(forward_cursor);
-            }
-            current_word = 0xC000 + (last_word << 2) + x;
-            bytes.remove_word(i);
-            i -= 2;
-            bytes.word_at(i, current_word);
-        }
-        else*/if(current_word <= 0x3F && last_word <= 0x3F)
+    ByteArray bytes;
+    bytes.reserve((steps[0].cost + 1) * 2);
+    for(size_t i = 0 ; i < tile_count ; i += steps[i].length)
+    {
+        uint16_t value = data_block[i];
+        uint16_t length = steps[i].length;
+        switch(steps[i].command)
         {
-            // 1 -> "1001AAAA AABBBBBB" case: place byte A then byte B as words
-            current_word = 0x9000 + (last_word << 6) + current_word;
-            bytes.remove_word(i);
-            i -= 2;
-            bytes.word_at(i, current_word);
+            case DataBlockCommand::RAW_WORD:
+                bytes.add_word(value);
+                break;
+            case DataBlockCommand::PACKED_BYTES:
+                bytes.add_word(0x9000 + (value << 6) + data_block[i + 1]);
+                break;
+            case DataBlockCommand::SKIP:
+                bytes.add_word(0x8000 + length);
+                break;
+            case DataBlockCommand::REPEAT_BYTE:
+                bytes.add_word(0xA000 + (length << 8) + value);
+                break;
+            case DataBlockCommand::REPEAT_WORD:
+                bytes.add_word(0xB000 + length);
+                bytes.add_word(value);
+                break;
+            case DataBlockCommand::REPEAT_INVERTED_WORD:
+                bytes.add_word(0xD000 + (value >> 4) + (length - 2));
+                break;
+            case DataBlockCommand::REPEAT_SMALL_WORD:
+                bytes.add_word(0xE000 + (value << 2) + (length - 2));
+                break;
+            case DataBlockCommand::INCREMENTING_RUN:
+                bytes.add_word(0xC000 + (value << 2) + (length - 2));
+                break;
         }
     }
 
+    // "10000000 00000000": end of block
+    bytes.add_word(0x8000);
     return bytes;
 }
 
-ByteArray io::encode_map_layout(MapLayout* layout)
+ByteArray io::encode_map_layout(MapLayout* layout, bool incrementing_runs)
 {
     ByteArray data;
 
@@ -138,8 +162,8 @@ ByteArray io::encode_map_layout(MapLayout* layout)
     data.add_byte(layout->width()); // = 14 = words to copy for each line (before going to next chunk)
     data.add_byte(layout->heightmap_width());
 
-    data.add_bytes(encode_data_block(layout->foreground_tiles(), 0x0000));
-    data.add_bytes(encode_data_block(layout->background_tiles(), 0x0000));
+    data.add_bytes(encode_data_block(layout->foreground_tiles(), 0x0000, incrementing_runs));
+    data.add_bytes(encode_data_block(layout->background_tiles(), 0x0000, incrementing_runs));
 
 //    std::vector<uint16_t> swapped_heightmap = layout->heightmap();
 //    for(size_t i=0 ; i<swapped_heightmap.size() ; ++i)
@@ -152,7 +176,67 @@ ByteArray io::encode_map_layout(MapLayout* layout)
 //    }
 //    data.add_bytes(encode_data_block(swapped_heightmap, 0x0040));
 
-    data.add_bytes(encode_data_block(layout->heightmap(), 0x4000));
+    data.add_bytes(encode_data_block(layout->heightmap(), 0x4000, incrementing_runs));
+
+    return data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Size of a line inside the map buffers filled by the loader
+static constexpr uint16_t LINE_SIZE_IN_BYTES = 74 * 2;
+
+bool io::can_encode_map_layout_delta(MapLayout* layout, MapLayout* base_layout)
+{
+    // Patches are applied on top of the base layout as placed by the loader, which depends on this header
+    return layout->top() == base_layout->top() && layout->left() == base_layout->left()
+        && layout->width() == base_layout->width() && layout->heightmap_width() == base_layout->heightmap_width();
+}
+
+/**
+ * Adds a (buffer offset, value) patch for each word differing between both blocks, considering missing trailing
+ * values as default values, followed by a 0xFFFF terminator.
+ * @param origin the offset in bytes from the start of the map buffer to the first word of the block
+ */
+static void encode_delta_block(ByteArray& bytes, const std::vector<uint16_t>& block, const std::vector<uint16_t>& base_block,
+                               uint16_t default_value, uint16_t origin, uint8_t width)
+{
+    if(width == 0 && (!block.empty() || !base_block.empty()))
+        throw LandstalkerException("Map layout has data but a width of 0");
+
+    for(size_t i=0 ; i<std::max(block.size(), base_block.size()) ; ++i)
+    {
+        uint16_t value = (i < block.size()) ? block[i] : default_value;
+        uint16_t base_value = (i < base_block.size()) ? base_block[i] : default_value;
+        if(value == base_value)
+            continue;
+
+        size_t offset = origin + (i / width) * LINE_SIZE_IN_BYTES + (i % width) * 2;
+        if(offset >= 0x8000)
+            throw LandstalkerException("Map layout does not fit in the map buffer");
+        bytes.add_word((uint16_t)offset);
+        bytes.add_word(value);
+    }
+    bytes.add_word(0xFFFF);
+}
+
+ByteArray io::encode_map_layout_delta(MapLayout* layout, MapLayout* base_layout, uint32_t base_layout_addr)
+{
+    if(!can_encode_map_layout_delta(layout, base_layout))
+        throw LandstalkerException("Cannot encode a map layout as a delta from a layout with a different position or size");
+
+    ByteArray data;
+    data.add_byte(0xFF); // Delta marker, replacing top which is always below 74 in full layouts
+    data.add_byte(0x00);
+    data.add_long(base_layout_addr);
+
+    uint16_t tiles_origin = (layout->top() * LINE_SIZE_IN_BYTES) + (layout->left() * 2);
+    encode_delta_block(data, layout->foreground_tiles(), base_layout->foreground_tiles(), 0x0000, tiles_origin, layout->width());
+    encode_delta_block(data, layout->background_tiles(), base_layout->background_tiles(), 0x0000, tiles_origin, layout->width());
+
+    // Heightmap is always placed at line 12, column 12
+    uint16_t heightmap_origin = (0xC * LINE_SIZE_IN_BYTES) + (0xC * 2);
+    encode_delta_block(data, layout->heightmap(), base_layout->heightmap(), 0x4000, heightmap_origin, layout->heightmap_width());
 
     return data;
 }
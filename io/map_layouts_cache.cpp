@@ -0,0 +1,172 @@
+#include "map_layouts_cache.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include "../model/map_layout.hpp"
+
+constexpr char CACHE_FILE_MAGIC[4] = { 'L', 'S', 'M', 'L' };
+
+/**
+ * Builds the entry identifying a layout besides its main hash. The check hash mixes whole words with a
+ * multiply / xor-shift step, so that it is unrelated to the byte-wise FNV-1a used by MapLayout::hash.
+ */
+MapLayoutsCache::Entry MapLayoutsCache::make_entry(const MapLayout& layout)
+{
+    Entry entry;
+    entry.header = { layout.left(), layout.top(), layout.width(), layout.height(),
+                     layout.heightmap_width(), layout.heightmap_height() };
+
+    uint64_t hash = 0x9E3779B97F4A7C15;
+    auto add_value = [&hash](uint64_t value) {
+        hash = (hash ^ value) * 0xBF58476D1CE4E5B9;
+        hash ^= hash >> 31;
+    };
+    for(const std::vector<uint16_t>* words : { &layout.foreground_tiles(), &layout.background_tiles(), &layout.heightmap() })
+    {
+        add_value(words->size());
+        for(uint16_t word : *words)
+            add_value(word);
+    }
+    entry.check_hash = hash;
+    return entry;
+}
+
+/**
+ * @return the encoded layout stored for the given layout if there is one, nullptr otherwise. An entry with the same
+ *         hash but a different header or check hash (meaning a hash collision) is not a hit.
+ */
+const ByteArray* MapLayoutsCache::find(uint64_t layout_hash, const MapLayout& layout)
+{
+    auto it = _entries.find(layout_hash);
+    if(it == _entries.end())
+        return nullptr;
+
+    Entry expected = make_entry(layout);
+    if(it->second.header != expected.header || it->second.check_hash != expected.check_hash)
+        return nullptr;
+
+    _used_hashes.insert(layout_hash);
+    return &it->second.encoded_layout;
+}
+
+void MapLayoutsCache::add(uint64_t layout_hash, const MapLayout& layout, const ByteArray& encoded_layout)
+{
+    Entry entry = make_entry(layout);
+    entry.encoded_layout = encoded_layout;
+    _entries[layout_hash] = std::move(entry);
+    _used_hashes.insert(layout_hash);
+    _modified = true;
+}
+
+static uint32_t read_number(std::ifstream& file, uint8_t byte_count)
+{
+    uint32_t value = 0;
+    for(uint8_t i=0 ; i<byte_count ; ++i)
+        value = (value << 8) | (uint8_t)file.get();
+    return value;
+}
+
+/**
+ * Loads encoded layouts from a cache file. Missing files, files with an unknown format and files written by
+ * another version of the encoder or with other encoder options are ignored, as they will be overwritten when
+ * saving the cache.
+ *
+ * File format: "LSML" magic, encoder version (word), encoder options (word), entry count (long), then for each entry
+ * the layout hash (two longs), layout header (six bytes), check hash (two longs), encoded size (long) and encoded bytes.
+ *
+ * @return true if entries were loaded from the file
+ */
+bool MapLayoutsCache::load_from_file(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+        return false;
+    std::streamoff file_size = file.tellg();
+    file.seekg(0);
+
+    char magic[4];
+    file.read(magic, 4);
+    if(!file || !std::equal(magic, magic + 4, CACHE_FILE_MAGIC))
+        return false;
+    if(read_number(file, 2) != MAP_LAYOUT_ENCODER_VERSION)
+        return false;
+    if(read_number(file, 2) != this->encoder_options())
+        return false;
+
+    std::map<uint64_t, Entry> entries;
+    uint32_t entry_count = read_number(file, 4);
+    for(uint32_t i=0 ; i<entry_count ; ++i)
+    {
+        uint64_t hash = ((uint64_t)read_number(file, 4) << 32) | read_number(file, 4);
+        Entry entry;
+        for(uint8_t& byte : entry.header)
+            byte = (uint8_t)read_number(file, 1);
+        entry.check_hash = ((uint64_t)read_number(file, 4) << 32) | read_number(file, 4);
+        uint32_t size = read_number(file, 4);
+        if(!file)
+            return false;
+
+        // Don't trust a size which goes past the end of the file, it would only come from a corrupted file
+        if(size > file_size - (std::streamoff)file.tellg())
+            return false;
+
+        entry.encoded_layout.resize(size);
+        file.read((char*)entry.encoded_layout.data(), size);
+        if(!file)
+            return false;
+        entries[hash] = std::move(entry);
+    }
+
+    // Only keep entries once the whole file was properly read, to prevent using a truncated file
+    for(auto& [hash, entry] : entries)
+        _entries.emplace(hash, std::move(entry));
+    return true;
+}
+
+/**
+ * Saves encoded layouts which were used since the cache was loaded to a cache file. The file is first written under
+ * a temporary name, then renamed, so that an interrupted or failed write never leaves a corrupted cache file behind.
+ *
+ * @return true if the cache file was written
+ */
+bool MapLayoutsCache::save_to_file(const std::string& path)
+{
+    ByteArray bytes;
+    bytes.insert(bytes.end(), CACHE_FILE_MAGIC, CACHE_FILE_MAGIC + 4);
+    bytes.add_word(MAP_LAYOUT_ENCODER_VERSION);
+    bytes.add_word(this->encoder_options());
+    bytes.add_long(_used_hashes.size());
+    for(uint64_t hash : _used_hashes)
+    {
+        const Entry& entry = _entries.at(hash);
+        bytes.add_long((uint32_t)(hash >> 32));
+        bytes.add_long((uint32_t)hash);
+        for(uint8_t byte : entry.header)
+            bytes.add_byte(byte);
+        bytes.add_long((uint32_t)(entry.check_hash >> 32));
+        bytes.add_long((uint32_t)entry.check_hash);
+        bytes.add_long(entry.encoded_layout.size());
+        bytes.add_bytes(entry.encoded_layout);
+    }
+
+    std::string temporary_path = path + ".tmp";
+    std::ofstream file(temporary_path, std::ios::binary);
+    if(!file.is_open())
+        return false;
+    file.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+    file.close();
+
+    std::error_code error;
+    if(file)
+        std::filesystem::rename(temporary_path, path, error);
+    if(!file || error)
+    {
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    _modified = false;
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+#include "../tools/byte_array.hpp"
+
+class MapLayout;
+
+/**
+ * Version of the map layout encoder output. It must be increased everytime the encoder is changed in a way that
+ * alters its output or the cache file format, so that encoded layouts stored by a previous version get discarded.
+ */
+constexpr uint16_t MAP_LAYOUT_ENCODER_VERSION = 4;
+
+/**
+ * A persistent cache of encoded map layouts, keyed by layout content hash (see MapLayout::hash), which can be
+ * loaded from and saved to a file so that layouts do not need to be encoded again from one run to the next.
+ *
+ * Since a hash collision would silently inject another layout into the ROM, each entry also stores the layout
+ * header (position and dimensions) and a second, independent hash of the layout contents, which must both match
+ * for a lookup to be a hit.
+ *
+ * Encoder options are stored in the file next to the encoder version, and a file encoded with different options
+ * is ignored like one from another encoder version.
+ *
+ * Only entries which were looked up or added since the cache was loaded are saved back, so that layouts which are
+ * not used anymore do not pile up in the file. Being only an optimization, file errors are never fatal.
+ */
+class MapLayoutsCache
+{
+public:
+    struct Entry
+    {
+        /// Left, top, width, height, heightmap width and heightmap height of the layout
+        std::array<uint8_t, 6> header {};
+        /// Hash of the layout contents computed independently from MapLayout::hash
+        uint64_t check_hash = 0;
+        ByteArray encoded_layout;
+    };
+
+private:
+    /// True if layouts are encoded using "incrementing run" commands (see io::encode_map_layout)
+    bool _incrementing_runs = false;
+    std::map<uint64_t, Entry> _entries;
+    std::set<uint64_t> _used_hashes;
+    bool _modified = false;
+
+public:
+    explicit MapLayoutsCache(bool incrementing_runs = false) : _incrementing_runs(incrementing_runs) {}
+
+    [[nodiscard]] const ByteArray* find(uint64_t layout_hash, const MapLayout& layout);
+    void add(uint64_t layout_hash, const MapLayout& layout, const ByteArray& encoded_layout);
+
+    [[nodiscard]] size_t size() const { return _entries.size(); }
+
+    /// @return true if saving the cache would change its file, either by adding or evicting entries
+    [[nodiscard]] bool modified() const { return _modified || _used_hashes.size() < _entries.size(); }
+
+    bool load_from_file(const std::string& path);
+    bool save_to_file(const std::string& path);
+
+private:
+    /// @return encoder options as stored in the cache file header, one bit per option
+    [[nodiscard]] uint16_t encoder_options() const { return _incrementing_runs ? 0x0001 : 0x0000; }
+
+    [[nodiscard]] static Entry make_entry(const MapLayout& layout);
+};
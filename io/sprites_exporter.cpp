@@ -0,0 +1,218 @@
+#include "io.hpp"
+
+#include <algorithm>
+#include <set>
+
+#include "../tools/sprite.hpp"
+#include "../tools/threadtools.hpp"
+#include "../tools/json.hpp"
+#include "../exceptions.hpp"
+
+/**
+ * Reads a table of longword pointers starting at `table_addr`. Since those tables are not terminated, the table is
+ * considered to end as soon as it reaches the lowest address pointed by the entries read so far, `hard_limit`,
+ * a null pointer or a pointer that does not fit inside the ROM.
+ */
+static std::vector<uint32_t> read_pointer_table(const md::ROM& rom, uint32_t table_addr, uint32_t hard_limit)
+{
+    std::vector<uint32_t> pointers;
+    uint32_t table_end = std::min<uint32_t>(hard_limit, rom.size());
+    for(uint32_t addr = table_addr ; addr + 4 <= table_end ; addr += 4)
+    {
+        uint32_t pointer = rom.get_long(addr);
+        if(pointer == 0 || pointer >= rom.size())
+            break;
+
+        pointers.emplace_back(pointer);
+        if(pointer > addr)
+            table_end = std::min(table_end, pointer);
+    }
+    return pointers;
+}
+
+std::vector<std::vector<uint32_t>> io::read_sprite_frame_addresses(const md::ROM& rom, uint32_t sprite_table_addr)
+{
+    std::vector<uint32_t> sprite_addresses = read_pointer_table(rom, sprite_table_addr, UINT32_MAX);
+
+    // Frame tables are stored one after the other, so each one cannot go past the next one
+    std::set<uint32_t> frame_table_starts(sprite_addresses.begin(), sprite_addresses.end());
+
+    std::vector<std::vector<uint32_t>> frame_addresses;
+    frame_addresses.reserve(sprite_addresses.size());
+    for(uint32_t sprite_addr : sprite_addresses)
+    {
+        auto next_table_it = frame_table_starts.upper_bound(sprite_addr);
+        uint32_t hard_limit = (next_table_it != frame_table_starts.end()) ? *next_table_it : UINT32_MAX;
+        frame_addresses.emplace_back(read_pointer_table(rom, sprite_addr, hard_limit));
+    }
+    return frame_addresses;
+}
+
+struct SpriteAtlasFrame {
+    size_t sprite_id = 0;
+    size_t frame_id = 0;
+    size_t palette_id = 0;
+    uint32_t address = 0;
+    SpriteImage image;
+    size_t atlas_id = 0;
+    uint16_t x = 0;
+    uint16_t y = 0;
+};
+
+/**
+ * Packs frames into as few atlases as possible using shelves: frames are sorted by decreasing height, then placed
+ * left to right on the current shelf until it is full, at which point a new shelf is started below.
+ * Atlases are numbered starting from `first_atlas_id`.
+ * @return the number of atlases needed
+ */
+static size_t pack_frames_in_atlases(std::vector<SpriteAtlasFrame*> sorted_frames, uint16_t atlas_size,
+                                     size_t first_atlas_id)
+{
+    std::stable_sort(sorted_frames.begin(), sorted_frames.end(), [](SpriteAtlasFrame* a, SpriteAtlasFrame* b) {
+        if(a->image.height != b->image.height)
+            return a->image.height > b->image.height;
+        return a->image.width > b->image.width;
+    });
+
+    size_t atlas_id = first_atlas_id;
+    size_t shelf_x = 0;
+    size_t shelf_y = 0;
+    size_t shelf_height = 0;
+    for(SpriteAtlasFrame* frame : sorted_frames)
+    {
+        if(frame->image.width > atlas_size || frame->image.height > atlas_size)
+            throw LandstalkerException("Sprite frame at address " + std::to_string(frame->address) + " does not fit in an atlas");
+
+        if(shelf_x + frame->image.width > atlas_size)
+        {
+            shelf_x = 0;
+            shelf_y += shelf_height;
+            shelf_height = 0;
+        }
+        if(shelf_y + frame->image.height > atlas_size)
+        {
+            ++atlas_id;
+            shelf_x = 0;
+            shelf_y = 0;
+            shelf_height = 0;
+        }
+
+        frame->atlas_id = atlas_id;
+        frame->x = shelf_x;
+        frame->y = shelf_y;
+        shelf_x += frame->image.width;
+        shelf_height = std::max<size_t>(shelf_height, frame->image.height);
+    }
+
+    return sorted_frames.empty() ? 0 : atlas_id + 1 - first_atlas_id;
+}
+
+void io::export_sprites_as_png_atlases(const md::ROM& rom,
+                                       const std::vector<std::vector<uint32_t>>& sprite_frame_addresses,
+                                       const std::vector<ColorPalette<16>>& palettes,
+                                       const std::vector<size_t>& sprite_palette_ids,
+                                       const std::string& output_directory,
+                                       uint16_t atlas_size,
+                                       size_t thread_count)
+{
+    if(sprite_palette_ids.size() != sprite_frame_addresses.size())
+        throw LandstalkerException("Sprite export needs exactly one palette ID per sprite");
+
+    std::vector<SpriteAtlasFrame> frames;
+    for(size_t sprite_id = 0 ; sprite_id < sprite_frame_addresses.size() ; ++sprite_id)
+    {
+        if(sprite_palette_ids[sprite_id] >= palettes.size())
+            throw LandstalkerException("Sprite " + std::to_string(sprite_id) + " uses an invalid palette ID");
+
+        const std::vector<uint32_t>& addresses = sprite_frame_addresses[sprite_id];
+        for(size_t frame_id = 0 ; frame_id < addresses.size() ; ++frame_id)
+        {
+            SpriteAtlasFrame& frame = frames.emplace_back();
+            frame.sprite_id = sprite_id;
+            frame.frame_id = frame_id;
+            frame.palette_id = sprite_palette_ids[sprite_id];
+            frame.address = addresses[frame_id];
+        }
+    }
+
+    // Decode and rasterize all frames in parallel, each one into its own image
+    const uint8_t* rom_end = rom.iterator_at(0) + rom.size();
+    threadtools::parallel_for(frames.size(), [&](size_t i) {
+        SpriteAtlasFrame& frame = frames[i];
+        frame.image = Sprite::decode_from(rom.iterator_at(frame.address), rom_end).rasterize();
+    }, thread_count);
+
+    // Atlases are written as indexed PNGs with a single palette, so frames are grouped by palette and each group
+    // gets its own atlases
+    std::vector<std::vector<SpriteAtlasFrame*>> frames_per_palette(palettes.size());
+    for(SpriteAtlasFrame& frame : frames)
+        frames_per_palette[frame.palette_id].emplace_back(&frame);
+
+    size_t atlas_count = 0;
+    std::vector<size_t> atlas_palette_ids;
+    for(size_t palette_id = 0 ; palette_id < palettes.size() ; ++palette_id)
+    {
+        size_t palette_atlas_count = pack_frames_in_atlases(frames_per_palette[palette_id], atlas_size, atlas_count);
+        atlas_palette_ids.insert(atlas_palette_ids.end(), palette_atlas_count, palette_id);
+        atlas_count += palette_atlas_count;
+    }
+
+    std::vector<std::vector<SpriteAtlasFrame*>> frames_per_atlas(atlas_count);
+    for(SpriteAtlasFrame& frame : frames)
+        frames_per_atlas[frame.atlas_id].emplace_back(&frame);
+
+    auto atlas_file_name = [](size_t atlas_id) { return "sprites_atlas_" + std::to_string(atlas_id) + ".png"; };
+
+    // Blit frames into their atlas and encode atlases in parallel
+    threadtools::parallel_for(atlas_count, [&](size_t atlas_id) {
+        // Only use the height actually needed by the frames to avoid writing huge empty areas
+        SpriteImage atlas;
+        atlas.width = atlas_size;
+        for(SpriteAtlasFrame* frame : frames_per_atlas[atlas_id])
+            atlas.height = std::max<uint16_t>(atlas.height, frame->y + frame->image.height);
+
+        atlas.pixels.resize(atlas.width * atlas.height, 0);
+        for(SpriteAtlasFrame* frame : frames_per_atlas[atlas_id])
+        {
+            for(size_t y = 0 ; y < frame->image.height ; ++y)
+            {
+                auto row_begin = frame->image.pixels.begin() + (long)(y * frame->image.width);
+                std::copy(row_begin, row_begin + frame->image.width,
+                          atlas.pixels.begin() + (long)((frame->y + y) * atlas.width + frame->x));
+            }
+        }
+
+        atlas.write_to_png(output_directory + "/" + atlas_file_name(atlas_id), palettes[atlas_palette_ids[atlas_id]]);
+    }, thread_count);
+
+    Json index_json = Json::object();
+    index_json["atlases"] = Json::array();
+    for(size_t atlas_id = 0 ; atlas_id < atlas_count ; ++atlas_id)
+    {
+        Json atlas_json = Json::object();
+        atlas_json["file"] = atlas_file_name(atlas_id);
+        atlas_json["palette"] = atlas_palette_ids[atlas_id];
+        index_json["atlases"].emplace_back(atlas_json);
+    }
+
+    Json sprites_json = Json::array();
+    for(size_t i=0 ; i<sprite_frame_addresses.size() ; ++i)
+        sprites_json.emplace_back(Json::array());
+    for(const SpriteAtlasFrame& frame : frames)
+    {
+        Json frame_json = Json::object();
+        frame_json["address"] = frame.address;
+        frame_json["atlas"] = frame.atlas_id;
+        frame_json["palette"] = frame.palette_id;
+        frame_json["x"] = frame.x;
+        frame_json["y"] = frame.y;
+        frame_json["width"] = frame.image.width;
+        frame_json["height"] = frame.image.height;
+        frame_json["originX"] = frame.image.origin_x;
+        frame_json["originY"] = frame.image.origin_y;
+        sprites_json[frame.sprite_id].emplace_back(frame_json);
+    }
+    index_json["sprites"] = sprites_json;
+
+    dump_json_to_file(index_json, output_directory + "/sprites_atlas.json");
+}
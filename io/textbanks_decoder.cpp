@@ -2,6 +2,10 @@
 
 #include "../constants/offsets.hpp"
 #include "../tools/huffman_tree.hpp"
+#include "../tools/byte_array.hpp"
+#include "../exceptions.hpp"
+
+#include <memory>
 
 constexpr uint16_t STRINGS_PER_TEXTBANK = 256;
 
@@ -9,8 +13,9 @@ constexpr uint16_t STRINGS_PER_TEXTBANK = 256;
 
 HuffmanTree* io::decode_huffman_tree(const md::ROM& rom, uint32_t addr)
 {
-    HuffmanTree* tree = new HuffmanTree();
-    HuffmanTreeNode* current_node = tree->root_node();
+    // Tree is only handed over to the caller once fully decoded, so that it is not leaked if the data is invalid
+    auto tree = std::make_unique<HuffmanTree>();
+    uint16_t current_node = HuffmanTree::ROOT_NODE;
     uint32_t current_symbol_addr = addr - 1;
 
     BitstreamReader bitstream(rom.iterator_at(addr));
@@ -20,62 +25,187 @@ HuffmanTree* io::decode_huffman_tree(const md::ROM& rom, uint32_t addr)
         if(!bitstream.next_bit())
         {
             // Branch node case
-            current_node->left_child(new HuffmanTreeNode());
-            current_node = current_node->left_child();
+            current_node = tree->add_left_child(current_node);
         }
         else
         {
             // Leaf node case: read the symbol value BEFORE the initial offset
-            current_node->symbol(rom.get_byte(current_symbol_addr));
+            uint8_t symbol = rom.get_byte(current_symbol_addr);
+            if(symbol >= SYMBOL_COUNT)
+                throw LandstalkerException("Huffman tree at address " + std::to_string(addr) + " contains invalid symbol " + std::to_string(symbol));
+            tree->node(current_node).symbol(symbol);
             current_symbol_addr -= 1;
 
             // If current node's parent has a right child, it means we completed this branch of the tree
             // and we need to get back at a higher level
-            while (current_node->parent() && current_node->parent()->right_child())
+            uint16_t parent = tree->node(current_node).parent();
+            while (parent != HuffmanTreeNode::NONE && tree->node(parent).right_child() != HuffmanTreeNode::NONE)
             {
-                current_node = current_node->parent();
+                current_node = parent;
+                parent = tree->node(current_node).parent();
             }
 
             // If we got back to root node, it means the whole tree is finished
-            if (current_node == tree->root_node())
-                return tree;
+            if (current_node == HuffmanTree::ROOT_NODE)
+            {
+                tree->build_decoding_table();
+                tree->build_encoding_table();
+                return tree.release();
+            }
 
-            current_node->parent()->right_child(new HuffmanTreeNode());
-            current_node = current_node->parent()->right_child();
+            current_node = tree->add_right_child(parent);
         }
     }
 }
 
+std::vector<HuffmanTree*> io::decode_huffman_trees(const md::ROM& rom)
+{
+    uint32_t huffman_trees_base_addr = offsets::HUFFMAN_TREE_OFFSETS + (SYMBOL_COUNT * 2);
+
+    // Trees are owned here until all of them are decoded, so that an invalid tree does not leak the previous ones
+    std::vector<std::unique_ptr<HuffmanTree>> decoded_trees;
+
+    std::vector<uint16_t> trees_offsets = rom.get_words(offsets::HUFFMAN_TREE_OFFSETS, huffman_trees_base_addr);
+    for(uint16_t tree_offset : trees_offsets)
+    {
+        if (tree_offset == 0xFFFF)
+            decoded_trees.emplace_back(nullptr);
+        else
+            decoded_trees.emplace_back(io::decode_huffman_tree(rom, huffman_trees_base_addr + tree_offset));
+    }
+
+    std::vector<HuffmanTree*> huffman_trees;
+    for(std::unique_ptr<HuffmanTree>& tree : decoded_trees)
+        huffman_trees.emplace_back(tree.release());
+    return huffman_trees;
+}
+
+std::vector<uint32_t> io::read_textbank_addresses(const md::ROM& rom)
+{
+    uint32_t textbank_table_addr = rom.get_long(offsets::TEXTBANKS_TABLE_POINTER);
+    std::vector<uint32_t> textbank_addrs;
+    for(uint32_t addr = textbank_table_addr ; rom.get_long(addr) != 0xFFFFFFFF ; addr += 0x4)
+        textbank_addrs.push_back(rom.get_long(addr));
+    return textbank_addrs;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 
-static std::string decode_string(BitstreamReader& bitstream, const std::vector<HuffmanTree*>& huffman_trees)
+/**
+ * A bit reader over a single encoded string, buffering up to 64 bits so that several bits can be peeked at once.
+ * Reading past the end of the string yields zeroes.
+ */
+class StringBitReader
+{
+private:
+    const uint8_t* _it;
+    const uint8_t* _end;
+    uint64_t _buffer = 0;
+    uint8_t _buffered_bits = 0;
+
+public:
+    StringBitReader(const uint8_t* begin, const uint8_t* end) : _it(begin), _end(end)
+    {}
+
+    uint32_t peek_bits(uint8_t amount)
+    {
+        if(_buffered_bits < amount)
+            this->refill();
+        return amount ? static_cast<uint32_t>(_buffer >> (64 - amount)) : 0;
+    }
+
+    void skip_bits(uint8_t amount)
+    {
+        _buffer <<= amount;
+        _buffered_bits -= amount;
+    }
+
+private:
+    void refill()
+    {
+        while(_buffered_bits <= 56)
+        {
+            uint64_t byte = (_it < _end) ? *_it++ : 0;
+            _buffer |= byte << (56 - _buffered_bits);
+            _buffered_bits += 8;
+        }
+    }
+};
+
+static uint8_t decode_symbol(StringBitReader& bitstream, const HuffmanTree* tree)
+{
+    const std::vector<HuffmanDecodingTableEntry>& table = tree->decoding_table();
+    uint8_t bits = tree->decoding_table_root_bits();
+    size_t offset = 0;
+
+    while(true)
+    {
+        const HuffmanDecodingTableEntry& entry = table[offset + bitstream.peek_bits(bits)];
+        if(!entry.is_link)
+        {
+            bitstream.skip_bits(entry.length);
+            return static_cast<uint8_t>(entry.value);
+        }
+
+        bitstream.skip_bits(bits);
+        offset = entry.value;
+        bits = entry.length;
+    }
+}
+
+static std::string decode_string(StringBitReader& bitstream, const std::vector<HuffmanTree*>& huffman_trees)
 {
     std::string string;
     uint8_t previous_symbol = 0x55;
 
     while (true)
     {
-        HuffmanTreeNode* current_node = huffman_trees[previous_symbol]->root_node();
-        while(!current_node->is_leaf())
+        uint8_t symbol = decode_symbol(bitstream, huffman_trees[previous_symbol]);
+        if (symbol == 0x55)
+            break;
+
+        string += Symbols::CHAR_FOR_SYMBOL[symbol];
+        previous_symbol = symbol;
+    }
+
+    return string;
+}
+
+static std::string decode_string_by_walking_trees(BitstreamReader& bitstream, const std::vector<HuffmanTree*>& huffman_trees)
+{
+    std::string string;
+    uint8_t previous_symbol = 0x55;
+
+    while (true)
+    {
+        const HuffmanTree* tree = huffman_trees[previous_symbol];
+        uint16_t current_node = HuffmanTree::ROOT_NODE;
+        while(!tree->node(current_node).is_leaf())
         {
             if (bitstream.next_bit())
-                current_node = current_node->right_child();
+                current_node = tree->node(current_node).right_child();
             else
-                current_node = current_node->left_child();
+                current_node = tree->node(current_node).left_child();
         }
 
-        uint8_t symbol = current_node->symbol();
+        uint8_t symbol = tree->node(current_node).symbol();
         if (symbol == 0x55)
             break;
 
-        string += Symbols::TABLE[symbol];
+        string += Symbols::CHAR_FOR_SYMBOL[symbol];
         previous_symbol = symbol;
     }
 
     return string;
 }
 
-std::vector<std::string> io::decode_textbanks(const md::ROM& rom, const std::vector<uint32_t>& addrs, const std::vector<HuffmanTree*>& huffman_trees)
+/**
+ * Decodes all strings from the given textbanks.
+ * @param use_decoding_tables if true, decode strings using the decoding tables of the trees (built along with
+ *        the trees), otherwise walk the trees one bit at a time
+ */
+std::vector<std::string> io::decode_textbanks(const md::ROM& rom, const std::vector<uint32_t>& addrs,
+                                              const std::vector<HuffmanTree*>& huffman_trees, bool use_decoding_tables)
 {
     std::vector<std::string> strings;
     strings.reserve(addrs.size() * STRINGS_PER_TEXTBANK);
@@ -88,9 +218,16 @@ std::vector<std::string> io::decode_textbanks(const md::ROM& rom, const std::vec
             if(string_length == 0)
                 break;
 
-            BitstreamReader bitstream(rom.iterator_at(addr + 1));
-            std::string string = decode_string(bitstream, huffman_trees);
-            strings.emplace_back(string);
+            if(use_decoding_tables)
+            {
+                StringBitReader bitstream(rom.iterator_at(addr + 1), rom.iterator_at(addr) + string_length);
+                strings.emplace_back(decode_string(bitstream, huffman_trees));
+            }
+            else
+            {
+                BitstreamReader bitstream(rom.iterator_at(addr + 1));
+                strings.emplace_back(decode_string_by_walking_trees(bitstream, huffman_trees));
+            }
             addr += string_length;
         }
     }
@@ -98,3 +235,35 @@ std::vector<std::string> io::decode_textbanks(const md::ROM& rom, const std::vec
     return strings;
 }
 
+/**
+ * Decodes a single string as stored in a textbank (a length byte followed by Huffman-encoded symbols)
+ */
+std::string io::decode_encoded_string(const ByteArray& encoded_string, const std::vector<HuffmanTree*>& huffman_trees)
+{
+    if(encoded_string.empty())
+        return "";
+
+    StringBitReader bitstream(encoded_string.data() + 1, encoded_string.data() + encoded_string.size());
+    return decode_string(bitstream, huffman_trees);
+}
+
+std::vector<ByteArray> io::read_encoded_strings(const md::ROM& rom, const std::vector<uint32_t>& addrs)
+{
+    std::vector<ByteArray> encoded_strings;
+    encoded_strings.reserve(addrs.size() * STRINGS_PER_TEXTBANK);
+
+    for(uint32_t addr : addrs)
+    {
+        for(uint32_t i = 0 ; i < STRINGS_PER_TEXTBANK ; ++i)
+        {
+            uint8_t string_length = rom.get_byte(addr);
+            if(string_length == 0)
+                break;
+
+            encoded_strings.emplace_back(rom.get_bytes(addr, addr + string_length));
+            addr += string_length;
+        }
+    }
+
+    return encoded_strings;
+}
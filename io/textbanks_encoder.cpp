@@ -4,29 +4,26 @@
 #include "../tools/byte_array.hpp"
 #include "../constants/symbols.hpp"
 #include "../tools/huffman_tree.hpp"
+#include "../tools/threadtools.hpp"
+#include "textbanks_encoding_cache.hpp"
 
 #include <iostream>
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdlib>
+#include <set>
+#include <string_view>
+#include <utility>
 
-static uint8_t char_to_symbol(char c)
-{
-    for (uint8_t symbol_id = 0; symbol_id < SYMBOL_COUNT; symbol_id++)
-        if(c == Symbols::TABLE[symbol_id])
-            return symbol_id;
-
-    return 0xFF;
-}
-
-static std::vector<uint8_t> string_to_symbols(const std::string& string)
+static std::vector<uint8_t> string_to_symbols(std::string_view string)
 {
     std::vector<uint8_t> string_as_symbols;
     string_as_symbols.reserve(string.size() + 1);
 
     for (char c : string)
     {
-        uint8_t symbol = char_to_symbol(c);
+        uint8_t symbol = Symbols::byte_for_symbol(c);
         if (symbol != 0xFF)
             string_as_symbols.emplace_back(symbol);
     }
@@ -35,23 +32,45 @@ static std::vector<uint8_t> string_to_symbols(const std::string& string)
     return string_as_symbols;
 }
 
-std::vector<HuffmanTree*> io::build_trees_from_strings(const std::vector<std::string>& strings)
+template<typename Histogram>
+static void add_to_histogram(Histogram& histogram, const std::vector<uint8_t>& string_as_symbols, int32_t weight = 1)
 {
-    // Step 1: Convert strings into LS character table symbols, and count successors for each symbol
-    std::array<std::array<uint32_t, SYMBOL_COUNT>, SYMBOL_COUNT> symbol_counts {};
-    for (const std::string& string : strings)
+    uint8_t previous_symbol = 0x55;
+    for (uint8_t symbol : string_as_symbols)
     {
-        std::vector<uint8_t> string_as_symbols = string_to_symbols(string);
-
-        uint8_t previous_symbol = 0x55;
-        for (uint8_t symbol : string_as_symbols)
-        {
-            symbol_counts[previous_symbol][symbol]++;
-            previous_symbol = symbol;
-        }
+        histogram[previous_symbol][symbol] += weight;
+        previous_symbol = symbol;
     }
+}
+
+template<typename StringList>
+static SymbolHistogram count_symbols(const StringList& strings, size_t thread_count)
+{
+    // Convert strings into LS character table symbols, and count successors for each symbol.
+    // Each thread counts symbols for a contiguous chunk of strings in its own histogram, histograms are summed afterwards.
+    size_t chunk_count = std::min(threadtools::resolve_thread_count(thread_count), std::max<size_t>(strings.size(), 1));
+    size_t chunk_size = (strings.size() + chunk_count - 1) / chunk_count;
+    std::vector<SymbolHistogram> histograms(chunk_count);
+    threadtools::parallel_for(chunk_count, [&](size_t chunk_id) {
+        SymbolHistogram& histogram = histograms[chunk_id];
+        histogram = {};
 
-    // Step 2: For each symbol, sort counts by descending order to have the most common symbol chains first
+        size_t end = std::min(strings.size(), (chunk_id + 1) * chunk_size);
+        for (size_t i = chunk_id * chunk_size ; i < end ; ++i)
+            add_to_histogram(histogram, string_to_symbols(strings[i]));
+    }, thread_count);
+
+    SymbolHistogram symbol_counts {};
+    for (const SymbolHistogram& histogram : histograms)
+        for (uint8_t i=0 ; i < SYMBOL_COUNT ; ++i)
+            for (uint8_t j=0 ; j < SYMBOL_COUNT ; ++j)
+                symbol_counts[i][j] += histogram[i][j];
+    return symbol_counts;
+}
+
+static std::vector<HuffmanTree*> build_trees_from_histogram(const SymbolHistogram& symbol_counts, bool optimal_trees)
+{
+    // Step 1: For each symbol, sort counts by descending order to have the most common symbol chains first
     std::array<std::vector<SymbolCount>, SYMBOL_COUNT> successor_counts_per_symbol;
     for (uint8_t i=0 ; i < SYMBOL_COUNT ; ++i)
     {
@@ -63,18 +82,24 @@ std::vector<HuffmanTree*> io::build_trees_from_strings(const std::vector<std::st
         std::sort(successors_count.begin(), successors_count.end());
     }
 
-    // Step 3: Build Huffman trees using those counts
+    // Step 2: Build Huffman trees using those counts
     std::vector<HuffmanTree*> trees;
     for (const std::vector<SymbolCount>& successor_counts : successor_counts_per_symbol)
     {
         if(!successor_counts.empty())
-            trees.emplace_back(new HuffmanTree(successor_counts));
+            trees.emplace_back(new HuffmanTree(successor_counts, optimal_trees));
         else
             trees.emplace_back(nullptr);
     }
     return trees;
 }
 
+std::vector<HuffmanTree*> io::build_trees_from_strings(const std::vector<std::string>& strings, bool optimal_trees,
+                                                       size_t thread_count)
+{
+    return build_trees_from_histogram(count_symbols(strings, thread_count), optimal_trees);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void io::encode_huffman_trees(const std::vector<HuffmanTree*>& huffman_trees,
@@ -102,33 +127,477 @@ void io::encode_huffman_trees(const std::vector<HuffmanTree*>& huffman_trees,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::vector<ByteArray> io::encode_textbanks(const std::vector<std::string>& strings, const std::vector<HuffmanTree*>& huffman_trees)
+static void check_string_length(std::string_view string, size_t string_id)
+{
+    if(string.size() > 0xFE)
+        throw LandstalkerException("String #" + std::to_string(string_id) + " is too long (" + std::to_string(string.size()) + " chars) to be integrated in textbanks ('" + std::string(string) + "')");
+}
+
+/**
+ * Encodes a string as it is stored inside a textbank: a length byte followed by its Huffman-encoded symbols
+ */
+static ByteArray encode_string(const std::vector<uint8_t>& string_as_symbols, const std::vector<HuffmanTree*>& huffman_trees)
 {
+    uint8_t previous_symbol = 0x55;
+    BitstreamWriter bitstream;
+    for (uint8_t symbol : string_as_symbols)
+    {
+        const HuffmanCode& code = huffman_trees[previous_symbol]->encode(symbol);
+        bitstream.add_number(code.bits, code.length);
+        previous_symbol = symbol;
+    }
+
+    const std::vector<uint8_t>& encoded_bytes = bitstream.bytes();
+    ByteArray encoded_string;
+    encoded_string.add_byte(encoded_bytes.size() + 1);
+    encoded_string.add_bytes(encoded_bytes);
+    return encoded_string;
+}
+
+/**
+ * @return true if every symbol pair of the string has a code in the given trees
+ */
+static bool can_encode_string(const std::vector<uint8_t>& string_as_symbols, const std::vector<HuffmanTree*>& huffman_trees)
+{
+    uint8_t previous_symbol = 0x55;
+    for (uint8_t symbol : string_as_symbols)
+    {
+        const HuffmanTree* tree = huffman_trees[previous_symbol];
+        if(!tree || !tree->can_encode(symbol))
+            return false;
+        previous_symbol = symbol;
+    }
+    return true;
+}
+
+std::vector<ByteArray> io::encode_textbanks(const std::vector<std::string>& strings, const std::vector<HuffmanTree*>& huffman_trees,
+                                            size_t thread_count)
+{
+    // Check strings beforehand, so that the reported error does not depend on the order in which banks are encoded
+    for (size_t i=0 ; i<strings.size() ; ++i)
+        check_string_length(strings[i], i);
+
     std::vector<ByteArray> textbanks;
     textbanks.resize((size_t)std::ceil((double)strings.size() / 256.0));
 
+    // Banks are independent from each other once trees are built, so they can be encoded concurrently
+    threadtools::parallel_for(textbanks.size(), [&](size_t bank_id) {
+        ByteArray& current_textbank = textbanks[bank_id];
+
+        size_t end = std::min(strings.size(), (bank_id + 1) * 256);
+        for (size_t i = bank_id * 256 ; i < end ; ++i)
+            current_textbank.add_bytes(encode_string(string_to_symbols(strings[i]), huffman_trees));
+    }, thread_count);
+
+    return textbanks;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Computes a FNV-1a hash of serialized trees, used to know if strings encoded with a previous tree set are still valid
+ */
+static uint64_t hash_trees(const ByteArray& tree_offsets, const ByteArray& tree_data)
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    for(const ByteArray* bytes : { &tree_offsets, &tree_data })
+    {
+        for(uint8_t byte : *bytes)
+        {
+            hash ^= byte;
+            hash *= 0x100000001B3;
+        }
+    }
+    return hash;
+}
+
+static void set_cache_trees(TextbanksEncodingCache& cache, const std::vector<HuffmanTree*>& trees, bool optimal_trees)
+{
+    cache.clear_trees();
+    cache.trees = trees;
+    cache.optimal_trees = optimal_trees;
+    cache.tree_offsets.clear();
+    cache.tree_data.clear();
+    io::encode_huffman_trees(cache.trees, cache.tree_offsets, cache.tree_data);
+    cache.trees_hash = hash_trees(cache.tree_offsets, cache.tree_data);
+}
+
+static void stitch_textbank(TextbanksEncodingCache& cache, size_t bank_id)
+{
+    ByteArray& textbank = cache.textbanks[bank_id];
+    textbank.clear();
+    size_t end = std::min(cache.encoded_strings.size(), (bank_id + 1) * 256);
+    for (size_t i = bank_id * 256 ; i < end ; ++i)
+        textbank.add_bytes(cache.encoded_strings[i]);
+}
+
+static void stitch_all_textbanks(TextbanksEncodingCache& cache)
+{
+    cache.textbanks.resize((size_t)std::ceil((double)cache.encoded_strings.size() / 256.0));
+    for (size_t bank_id = 0 ; bank_id < cache.textbanks.size() ; ++bank_id)
+        stitch_textbank(cache, bank_id);
+}
+
+static uint64_t count_symbol_pairs(const SymbolHistogram& histogram)
+{
+    uint64_t symbol_pairs = 0;
+    for(const auto& successor_counts : histogram)
+        for(uint32_t count : successor_counts)
+            symbol_pairs += count;
+    return symbol_pairs;
+}
+
+/**
+ * @return the sum of absolute count differences between symbol statistics and the ones trees were built for, which
+ *         divided by the number of symbol pairs at build time gives the relative drift of statistics
+ */
+static uint64_t statistics_difference(const SymbolHistogramChanges& histogram_changes)
+{
+    uint64_t difference = 0;
+    for(const auto& successor_changes : histogram_changes)
+        for(int32_t change : successor_changes)
+            difference += (uint64_t)std::abs((int64_t)change);
+    return difference;
+}
+
+static int64_t count_symbol_pairs(const SymbolHistogramChanges& histogram_changes)
+{
+    int64_t symbol_pairs = 0;
+    for(const auto& successor_changes : histogram_changes)
+        for(int32_t change : successor_changes)
+            symbol_pairs += change;
+    return symbol_pairs;
+}
+
+void io::init_textbanks_encoding_cache(TextbanksEncodingCache& cache, const StringPool& strings,
+                                       const std::vector<HuffmanTree*>& huffman_trees,
+                                       const std::vector<ByteArray>& encoded_strings)
+{
+    set_cache_trees(cache, huffman_trees, false);
+    cache.encoded_strings = encoded_strings;
+    cache.histogram_changes = {};
+    if(strings.size() == encoded_strings.size())
+    {
+        cache.strings = strings;
+        cache.decoded_strings.clear();
+        cache.symbol_pairs_at_build = count_symbol_pairs(count_symbols(strings, 0));
+    }
+    else
+    {
+        // Strings were read lazily, their text will only be decoded once it is needed
+        cache.strings.clear();
+        cache.strings.resize(encoded_strings.size());
+        cache.decoded_strings.assign(encoded_strings.size(), false);
+        cache.symbol_pairs_at_build.reset();
+    }
+    stitch_all_textbanks(cache);
+}
+
+/**
+ * When strings were read lazily, cached strings are only known in their encoded form. Decodes the text of the given
+ * cached strings if it was not already.
+ */
+static void decode_cached_strings(TextbanksEncodingCache& cache, const std::vector<size_t>& ids, size_t thread_count)
+{
+    std::vector<size_t> ids_to_decode;
+    for(size_t id : ids)
+        if(!cache.is_decoded(id))
+            ids_to_decode.emplace_back(id);
+    if(ids_to_decode.empty())
+        return;
+
+    std::vector<std::string> decoded_strings(ids_to_decode.size());
+    threadtools::parallel_for(ids_to_decode.size(), [&](size_t i) {
+        decoded_strings[i] = io::decode_encoded_string(cache.encoded_strings[ids_to_decode[i]], cache.trees);
+    }, thread_count);
+    for(size_t i=0 ; i<ids_to_decode.size() ; ++i)
+    {
+        cache.strings.set(ids_to_decode[i], decoded_strings[i]);
+        cache.decoded_strings[ids_to_decode[i]] = true;
+    }
+
+    if(std::find(cache.decoded_strings.begin(), cache.decoded_strings.end(), false) == cache.decoded_strings.end())
+        cache.decoded_strings.clear();
+}
+
+static std::vector<size_t> ids_between(size_t begin, size_t end)
+{
+    std::vector<size_t> ids;
+    for(size_t id = begin ; id < end ; ++id)
+        ids.emplace_back(id);
+    return ids;
+}
+
+/**
+ * @return current strings, where strings which were not decoded are taken from the cache since they are still
+ *         the ones it encodes
+ */
+static StringPool gather_all_strings(const StringPool& strings, const std::vector<bool>& decoded_strings,
+                                     TextbanksEncodingCache& cache, size_t thread_count)
+{
+    std::vector<size_t> undecoded_ids;
+    for(size_t id = 0 ; id < decoded_strings.size() && id < strings.size() ; ++id)
+    {
+        if(decoded_strings[id])
+            continue;
+        if(id >= cache.encoded_strings.size())
+            throw LandstalkerException("String #" + std::to_string(id) + " was never decoded but is not in the textbanks encoding cache");
+        undecoded_ids.emplace_back(id);
+    }
+    if(undecoded_ids.empty())
+        return strings;
+
+    decode_cached_strings(cache, undecoded_ids, thread_count);
+    StringPool all_strings = strings;
+    for(size_t id : undecoded_ids)
+        all_strings.set(id, std::as_const(cache.strings)[id]);
+    return all_strings;
+}
+
+/**
+ * Makes current strings the cached ones. Strings which were not decoded keep the text already decoded by the cache
+ * if there is one, since they did not change.
+ */
+static void update_cached_strings(TextbanksEncodingCache& cache, const StringPool& strings,
+                                  const std::vector<bool>& decoded_strings)
+{
+    StringPool previous_strings = std::move(cache.strings);
+    std::vector<bool> previous_decoded_strings = std::move(cache.decoded_strings);
+    auto previously_decoded = [&](size_t id) {
+        return id < previous_strings.size() && (id >= previous_decoded_strings.size() || previous_decoded_strings[id]);
+    };
+
+    cache.strings = strings;
+    cache.decoded_strings.clear();
+    for(size_t id = 0 ; id < decoded_strings.size() && id < strings.size() ; ++id)
+    {
+        if(decoded_strings[id])
+            continue;
+
+        if(previously_decoded(id))
+        {
+            cache.strings.set(id, std::as_const(previous_strings)[id]);
+        }
+        else
+        {
+            if(cache.decoded_strings.empty())
+                cache.decoded_strings.assign(strings.size(), true);
+            cache.decoded_strings[id] = false;
+        }
+    }
+}
+
+/**
+ * @return a lower bound of the number of symbol pairs in cached strings, knowing that each string holds at least
+ *         one symbol and that no symbol is encoded using more bits than the longest code of the trees
+ */
+static uint64_t min_cached_symbol_pairs(const TextbanksEncodingCache& cache)
+{
+    uint8_t max_code_length = 1;
+    for(const HuffmanTree* tree : cache.trees)
+        if(tree)
+            for(uint8_t symbol = 0 ; symbol < SYMBOL_COUNT ; ++symbol)
+                if(tree->can_encode(symbol))
+                    max_code_length = std::max(max_code_length, tree->encode(symbol).length);
+
+    uint64_t symbol_pairs = 0;
+    for(const ByteArray& encoded_string : cache.encoded_strings)
+    {
+        // Encoded string starts with a length byte, and its last byte holds at least one bit
+        uint64_t bit_count = (encoded_string.size() >= 2) ? ((encoded_string.size() - 2) * 8) + 1 : 0;
+        symbol_pairs += std::max<uint64_t>((bit_count + max_code_length - 1) / max_code_length, 1);
+    }
+    return symbol_pairs;
+}
+
+/**
+ * @return true if symbol statistics with the given changes drifted too much from the ones trees were built for.
+ *         When strings were read lazily, the number of symbol pairs at build time is unknown: a lower bound is used
+ *         first, and cached strings only get all decoded to know the exact number if the bound is not enough.
+ */
+static bool statistics_drifted(TextbanksEncodingCache& cache, const SymbolHistogramChanges& histogram_changes,
+                               double max_statistics_drift, size_t thread_count)
+{
+    // Strings in the cache are the ones trees were built for, with the changes known to the cache
+    int64_t previous_changes = count_symbol_pairs(cache.histogram_changes);
+    uint64_t difference = statistics_difference(histogram_changes);
+
+    if(!cache.symbol_pairs_at_build)
+    {
+        int64_t min_symbol_pairs_at_build = (int64_t)min_cached_symbol_pairs(cache) - previous_changes;
+        if((double)difference <= max_statistics_drift * (double)std::max<int64_t>(min_symbol_pairs_at_build, 1))
+            return false;
+
+        decode_cached_strings(cache, ids_between(0, cache.strings.size()), thread_count);
+        int64_t cached_symbol_pairs = (int64_t)count_symbol_pairs(count_symbols(cache.strings, thread_count));
+        cache.symbol_pairs_at_build = (uint64_t)std::max<int64_t>(cached_symbol_pairs - previous_changes, 0);
+    }
+
+    return (double)difference > max_statistics_drift * (double)std::max<uint64_t>(*cache.symbol_pairs_at_build, 1);
+}
+
+static bool string_changed(const StringPool& strings, const StringPool& cached_strings, size_t id)
+{
+    return !strings.shares_string(cached_strings, id) && strings[id] != cached_strings[id];
+}
+
+/**
+ * Builds a new tree set from scratch. If it happens to be identical to the cached one, strings that did not change
+ * keep their cached encoding, otherwise all strings are encoded again.
+ */
+static void rebuild_textbanks_encoding_cache(const StringPool& strings, TextbanksEncodingCache& cache,
+                                             bool optimal_trees, size_t thread_count)
+{
     for (size_t i=0 ; i<strings.size() ; ++i)
+        check_string_length(strings[i], i);
+
+    SymbolHistogram histogram = count_symbols(strings, thread_count);
+    std::vector<HuffmanTree*> trees = build_trees_from_histogram(histogram, optimal_trees);
+
+    ByteArray tree_offsets, tree_data;
+    io::encode_huffman_trees(trees, tree_offsets, tree_data);
+    bool same_trees = !cache.empty() && cache.optimal_trees == optimal_trees
+                      && hash_trees(tree_offsets, tree_data) == cache.trees_hash
+                      && tree_offsets == cache.tree_offsets && tree_data == cache.tree_data;
+
+    std::vector<bool> needs_encoding(strings.size(), true);
+    if(same_trees)
+    {
+        for(HuffmanTree* tree : trees)
+            delete tree;
+        for (size_t i=0 ; i<strings.size() && i<cache.strings.size() ; ++i)
+            needs_encoding[i] = !cache.is_decoded(i) || string_changed(strings, cache.strings, i);
+    }
+    else
+    {
+        set_cache_trees(cache, trees, optimal_trees);
+    }
+
+    cache.encoded_strings.resize(strings.size());
+    threadtools::parallel_for(strings.size(), [&](size_t i) {
+        if(needs_encoding[i])
+            cache.encoded_strings[i] = encode_string(string_to_symbols(strings[i]), cache.trees);
+    }, thread_count);
+
+    cache.strings = strings;
+    cache.decoded_strings.clear();
+    cache.symbol_pairs_at_build = count_symbol_pairs(histogram);
+    cache.histogram_changes = {};
+    stitch_all_textbanks(cache);
+}
+
+void io::encode_textbanks_incrementally(const StringPool& strings, const std::vector<bool>& decoded_strings,
+                                        const std::set<uint16_t>* changed_string_ids,
+                                        TextbanksEncodingCache& cache,
+                                        bool optimal_trees, double max_statistics_drift, size_t thread_count)
+{
+    auto rebuild = [&]() {
+        StringPool all_strings = gather_all_strings(strings, decoded_strings, cache, thread_count);
+        rebuild_textbanks_encoding_cache(all_strings, cache, optimal_trees, thread_count);
+    };
+
+    if(cache.empty() || cache.optimal_trees != optimal_trees)
+    {
+        rebuild();
+        return;
+    }
+
+    // Strings which were not decoded are still the ones in the cache, so only decoded strings can have changed.
+    // Only look at strings reported as changed if possible.
+    auto is_decoded = [&decoded_strings](size_t id) { return id >= decoded_strings.size() || decoded_strings[id]; };
+    size_t cached_count = cache.strings.size();
+    std::vector<size_t> candidate_ids;
+    if(changed_string_ids)
     {
-        const std::string& string = strings[i];
-        if(string.size() > 0xFE)
-            throw LandstalkerException("String #" + std::to_string(i) + " is too long (" + std::to_string(string.size()) + " chars) to be integrated in textbanks ('" + string + "')");
+        for(uint16_t id : *changed_string_ids)
+            if(id < std::min(strings.size(), cached_count) && is_decoded(id))
+                candidate_ids.emplace_back(id);
+    }
+    else
+    {
+        for(size_t id = 0 ; id < std::min(strings.size(), cached_count) ; ++id)
+            if(is_decoded(id))
+                candidate_ids.emplace_back(id);
+    }
+
+    // Previous text of candidate and removed strings is needed to compare them and to update symbol statistics
+    std::vector<size_t> removed_ids = ids_between(strings.size(), cached_count);
+    std::vector<size_t> ids_to_decode = candidate_ids;
+    ids_to_decode.insert(ids_to_decode.end(), removed_ids.begin(), removed_ids.end());
+    decode_cached_strings(cache, ids_to_decode, thread_count);
+
+    std::vector<size_t> changed_ids;
+    for(size_t id : candidate_ids)
+        if(string_changed(strings, cache.strings, id))
+            changed_ids.emplace_back(id);
+    for(size_t id = cached_count ; id < strings.size() ; ++id)
+        changed_ids.emplace_back(id);
 
-        ByteArray& current_textbank = textbanks[i / 256];
+    if(changed_ids.empty() && removed_ids.empty())
+        return;
 
-        std::vector<uint8_t> string_as_symbols = string_to_symbols(string);
+    // Update symbol statistics with the changes, and check if current trees can still encode all changed strings
+    SymbolHistogramChanges histogram_changes = cache.histogram_changes;
+    for(size_t id : removed_ids)
+        add_to_histogram(histogram_changes, string_to_symbols(std::as_const(cache.strings)[id]), -1);
 
-        uint8_t previous_symbol = 0x55;
-        BitstreamWriter bitstream;
-        for (uint8_t symbol : string_as_symbols)
+    std::vector<std::vector<uint8_t>> changed_strings_as_symbols;
+    changed_strings_as_symbols.reserve(changed_ids.size());
+    for(size_t id : changed_ids)
+    {
+        check_string_length(strings[id], id);
+        if(id < cached_count)
+            add_to_histogram(histogram_changes, string_to_symbols(std::as_const(cache.strings)[id]), -1);
+
+        std::vector<uint8_t>& string_as_symbols = changed_strings_as_symbols.emplace_back(string_to_symbols(strings[id]));
+        add_to_histogram(histogram_changes, string_as_symbols);
+        if(!can_encode_string(string_as_symbols, cache.trees))
         {
-            bitstream.add_bits(huffman_trees[previous_symbol]->encode(symbol));
-            previous_symbol = symbol;
+            rebuild();
+            return;
         }
+    }
 
-        const std::vector<uint8_t>& encoded_bytes = bitstream.bytes();
-        current_textbank.add_byte(encoded_bytes.size() + 1);
-        current_textbank.add_bytes(encoded_bytes);
+    if(statistics_drifted(cache, histogram_changes, max_statistics_drift, thread_count))
+    {
+        rebuild();
+        return;
     }
+    cache.histogram_changes = histogram_changes;
 
-    return textbanks;
+    // Trees are still good enough: only encode changed strings, and stitch back the banks containing them
+    size_t previous_bank_count = cache.textbanks.size();
+    update_cached_strings(cache, strings, decoded_strings);
+    cache.encoded_strings.resize(strings.size());
+    threadtools::parallel_for(changed_ids.size(), [&](size_t i) {
+        cache.encoded_strings[changed_ids[i]] = encode_string(changed_strings_as_symbols[i], cache.trees);
+    }, thread_count);
+
+    std::set<size_t> banks_to_stitch;
+    for(size_t id : changed_ids)
+        banks_to_stitch.insert(id / 256);
+    cache.textbanks.resize((size_t)std::ceil((double)cache.encoded_strings.size() / 256.0));
+    if(!cache.textbanks.empty() && cache.textbanks.size() <= previous_bank_count)
+        banks_to_stitch.insert(cache.textbanks.size() - 1);
+    for(size_t bank_id : banks_to_stitch)
+        stitch_textbank(cache, bank_id);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t io::compute_encoded_strings_size(const std::vector<std::string>& strings, bool optimal_trees)
+{
+    std::vector<HuffmanTree*> huffman_trees = io::build_trees_from_strings(strings, optimal_trees);
+
+    ByteArray tree_offsets, tree_data;
+    io::encode_huffman_trees(huffman_trees, tree_offsets, tree_data);
+    size_t total_size = tree_offsets.size() + tree_data.size();
+
+    std::vector<ByteArray> textbanks = io::encode_textbanks(strings, huffman_trees);
+    for(const ByteArray& textbank : textbanks)
+        total_size += textbank.size();
+
+    for(HuffmanTree* tree : huffman_trees)
+        delete tree;
+    return total_size;
 }
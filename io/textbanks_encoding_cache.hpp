@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../constants/symbols.hpp"
+#include "../tools/byte_array.hpp"
+#include "../tools/huffman_tree.hpp"
+#include "../tools/string_pool.hpp"
+
+/// For each symbol, the number of times each other symbol follows it
+using SymbolHistogram = std::array<std::array<uint32_t, SYMBOL_COUNT>, SYMBOL_COUNT>;
+/// For each symbol, how many times each other symbol following it was added (or removed, if negative)
+using SymbolHistogramChanges = std::array<std::array<int32_t, SYMBOL_COUNT>, SYMBOL_COUNT>;
+
+/**
+ * Keeps the result of the last textbanks encoding (trees, and each string encoded with them), so that writing strings
+ * again only needs to re-encode strings which changed since then, as long as the same trees can still be used.
+ */
+struct TextbanksEncodingCache
+{
+    /// Huffman trees used to encode strings (owned by the cache)
+    std::vector<HuffmanTree*> trees;
+    /// Serialized trees, as they need to be written in the ROM
+    ByteArray tree_offsets;
+    ByteArray tree_data;
+    /// Hash of serialized trees, identifying the tree set which was used to encode strings
+    uint64_t trees_hash = 0;
+    /// True if trees were built using the optimal Huffman construction
+    bool optimal_trees = false;
+
+    /// Number of symbol pairs in strings when trees were built, which is only known once all strings were decoded
+    /// when they were read lazily
+    std::optional<uint64_t> symbol_pairs_at_build;
+    /// Changes in symbol statistics between strings when trees were built and strings currently in the cache
+    SymbolHistogramChanges histogram_changes {};
+
+    /// Text of each string and its encoded form (length byte followed by Huffman-encoded symbols)
+    StringPool strings;
+    std::vector<ByteArray> encoded_strings;
+    /// When strings were read lazily, tells for each string if its text is in `strings` (empty if all are).
+    /// Text is only decoded from the encoded form when the encoder needs it.
+    std::vector<bool> decoded_strings;
+
+    /// Encoded textbanks, each one being the concatenation of 256 encoded strings
+    std::vector<ByteArray> textbanks;
+
+    TextbanksEncodingCache() = default;
+    TextbanksEncodingCache(const TextbanksEncodingCache&) = delete;
+    TextbanksEncodingCache& operator=(const TextbanksEncodingCache&) = delete;
+
+    ~TextbanksEncodingCache()
+    {
+        this->clear_trees();
+    }
+
+    [[nodiscard]] bool empty() const { return trees.empty(); }
+    [[nodiscard]] bool is_decoded(size_t id) const { return id >= decoded_strings.size() || decoded_strings[id]; }
+
+    void clear_trees()
+    {
+        for(HuffmanTree* tree : trees)
+            delete tree;
+        trees.clear();
+    }
+};
@@ -5,6 +5,7 @@
 #include "../model/world.hpp"
 #include "../model/entity.hpp"
 #include "../model/blockset.hpp"
+#include "textbanks_encoding_cache.hpp"
 
 #include "../constants/offsets.hpp"
 #include "../constants/entity_type_codes.hpp"
@@ -380,29 +381,26 @@ static void read_maps(const md::ROM& rom, World& world)
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static void read_game_strings(const md::ROM& rom, World& world)
+static void read_game_strings(const md::ROM& rom, World& world, bool lazy)
 {
-    uint32_t huffman_trees_base_addr = offsets::HUFFMAN_TREE_OFFSETS + (SYMBOL_COUNT * 2);
+    std::vector<HuffmanTree*> huffman_trees = io::decode_huffman_trees(rom);
+    std::vector<uint32_t> textbank_addrs = io::read_textbank_addresses(rom);
+    std::vector<ByteArray> encoded_strings = io::read_encoded_strings(rom, textbank_addrs);
 
-    std::vector<HuffmanTree*> huffman_trees;
-
-    std::vector<uint16_t> trees_offsets = rom.get_words(offsets::HUFFMAN_TREE_OFFSETS, huffman_trees_base_addr);
-    for(uint16_t tree_offset : trees_offsets)
+    // Keep strings encoded as they are in the ROM, so that writing them back only needs to encode edited strings,
+    // and so that strings can be decoded later on when reading lazily. The encoding cache takes ownership of the trees.
+    if(lazy)
     {
-        if (tree_offset == 0xFFFF)
-            huffman_trees.emplace_back(nullptr);
-        else
-            huffman_trees.emplace_back(io::decode_huffman_tree(rom, huffman_trees_base_addr + tree_offset));
+        io::init_textbanks_encoding_cache(world.textbanks_encoding_cache(), {}, huffman_trees, encoded_strings);
+        world.defer_game_strings_decoding(encoded_strings.size());
     }
-
-    uint32_t textbank_table_addr = rom.get_long(offsets::TEXTBANKS_TABLE_POINTER);
-    std::vector<uint32_t> textbank_addrs;
-    for(uint32_t addr = textbank_table_addr ; rom.get_long(addr) != 0xFFFFFFFF ; addr += 0x4)
-        textbank_addrs.push_back(rom.get_long(addr));
-
-    world.game_strings() = io::decode_textbanks(rom, textbank_addrs, huffman_trees);
-    for(HuffmanTree* tree : huffman_trees)
-        delete tree;
+    else
+    {
+        world.game_strings() = StringPool(io::decode_textbanks(rom, textbank_addrs, huffman_trees));
+        io::init_textbanks_encoding_cache(world.textbanks_encoding_cache(), std::as_const(world).game_strings(),
+                                          huffman_trees, encoded_strings);
+    }
+    world.clear_dirty_game_strings();
 }
 
 static void read_entity_type_palettes(const md::ROM& rom, World& world)
@@ -612,11 +610,11 @@ static void read_chest_contents(const md::ROM& rom, World& world)
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void io::read_world_from_rom(const md::ROM& rom, World& world)
+void io::read_world_from_rom(const md::ROM& rom, World& world, const WorldReadOptions& options)
 {
     read_items(rom, world);
     read_chest_contents(rom, world);
-    read_game_strings(rom, world);
+    read_game_strings(rom, world, options.lazy_game_strings);
     read_blocksets(rom, world);
     read_entity_types(rom, world);
     read_maps(rom, world);
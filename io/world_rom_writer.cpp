@@ -1,7 +1,10 @@
 #include "io.hpp"
+#include "map_layouts_cache.hpp"
+#include "textbanks_encoding_cache.hpp"
 
 #include "../model/entity_type.hpp"
 #include "../model/map.hpp"
+#include "../model/map_layout.hpp"
 #include "../model/world.hpp"
 #include "../model/entity.hpp"
 
@@ -11,6 +14,7 @@
 
 #include "../tools/huffman_tree.hpp"
 #include "../tools/stringtools.hpp"
+#include "../tools/threadtools.hpp"
 
 #include <cstdint>
 #include <set>
@@ -288,17 +292,20 @@ static void write_entity_type_palettes(const World& world, md::ROM& rom)
     rom.set_bytes(offsets::ENTITY_PALETTES_TABLE_HIGH, high_palettes_bytes);
 }
 
-static void write_game_strings(const World& world, md::ROM& rom)
+static void write_game_strings(World& world, md::ROM& rom, const io::WorldWriteOptions& options)
 {
-    // Write Huffman tree offsets & tree data consecutively in the ROM
-    std::vector<HuffmanTree*> huffman_trees = io::build_trees_from_strings(world.game_strings());
-    ByteArray huffman_offsets;
-    ByteArray huffman_data;
-    io::encode_huffman_trees(huffman_trees, huffman_offsets, huffman_data);
+    // Only strings edited since last read or write are encoded again, unless trees need to be rebuilt. Strings which
+    // were read lazily and never accessed are left encoded as they are in the cache, without decoding them.
+    TextbanksEncodingCache& encoding_cache = world.textbanks_encoding_cache();
+    io::encode_textbanks_incrementally(world.stored_game_strings(), world.decoded_game_strings(),
+                                       world.dirty_game_string_ids(), encoding_cache, options.optimal_huffman_trees,
+                                       options.textbanks_rebuild_drift_threshold, options.thread_count);
+    world.clear_dirty_game_strings();
 
+    // Write Huffman tree offsets & tree data consecutively in the ROM
     rom.mark_empty_chunk(offsets::HUFFMAN_TREE_OFFSETS, offsets::HUFFMAN_TREES_END);
-    uint32_t offsets_addr = rom.inject_bytes(huffman_offsets);
-    uint32_t data_addr = rom.inject_bytes(huffman_data);
+    uint32_t offsets_addr = rom.inject_bytes(encoding_cache.tree_offsets);
+    uint32_t data_addr = rom.inject_bytes(encoding_cache.tree_data);
 
     // Slightly edit the decode function to make it point on the new Huffman trees' address
     md::Code proc;
@@ -312,9 +319,8 @@ static void write_game_strings(const World& world, md::ROM& rom)
     // Write textbanks to the ROM
     rom.mark_empty_chunk(offsets::FIRST_TEXTBANK, offsets::TEXTBANKS_TABLE_END);
 
-    std::vector<ByteArray> encoded_textbanks = io::encode_textbanks(world.game_strings(), huffman_trees);
     ByteArray textbanks_table_bytes;
-    for(const ByteArray& encoded_textbank : encoded_textbanks)
+    for(const ByteArray& encoded_textbank : encoding_cache.textbanks)
     {
         uint32_t textbank_addr = rom.inject_bytes(encoded_textbank);
         textbanks_table_bytes.add_long(textbank_addr);
@@ -323,9 +329,6 @@ static void write_game_strings(const World& world, md::ROM& rom)
 
     uint32_t textbanks_table_addr = rom.inject_bytes(textbanks_table_bytes);
     rom.set_long(offsets::TEXTBANKS_TABLE_POINTER, textbanks_table_addr);
-
-    for(HuffmanTree* tree : huffman_trees)
-        delete tree;
 }
 
 static void write_map_connections(const World& world, md::ROM& rom)
@@ -398,22 +401,161 @@ static void write_blocksets(const World& world, md::ROM& rom)
     rom.set_long(offsets::BLOCKSETS_GROUPS_TABLE_POINTER, blockset_groups_table_addr);
 }
 
-static std::map<MapLayout*, uint32_t> write_map_layouts(const World& world, md::ROM& rom)
+/**
+ * Finds variant map layouts which take less space when stored as patches to apply on top of the layout of their
+ * parent map. Layouts used as a base need to be stored in full, so they cannot be stored as patches themselves.
+ * @return the id of the base layout for each layout to store as patches
+ */
+static std::map<size_t, size_t> find_delta_map_layouts(const World& world, const std::vector<MapLayout*>& layouts,
+                                                       const std::vector<size_t>& source_layout_ids,
+                                                       const std::vector<ByteArray>& encoded_layouts)
+{
+    std::map<MapLayout*, size_t> layout_ids;
+    for(size_t i=0 ; i<layouts.size() ; ++i)
+        layout_ids[layouts[i]] = source_layout_ids[i];
+
+    std::map<size_t, size_t> base_layout_ids;
+    std::set<size_t> used_as_base;
+    for(const auto& [map_id, map] : world.maps())
+    {
+        if(!layout_ids.count(map->layout()))
+            continue;
+        size_t base_layout_id = layout_ids.at(map->layout());
+        if(base_layout_ids.count(base_layout_id))
+            continue;
+
+        for(const auto& [variant_map, flag] : map->variants())
+        {
+            if(!layout_ids.count(variant_map->layout()))
+                continue;
+            size_t layout_id = layout_ids.at(variant_map->layout());
+            if(layout_id == base_layout_id || base_layout_ids.count(layout_id) || used_as_base.count(layout_id))
+                continue;
+
+            MapLayout* layout = layouts[layout_id];
+            MapLayout* base_layout = layouts[base_layout_id];
+            if(!io::can_encode_map_layout_delta(layout, base_layout))
+                continue;
+            if(io::encode_map_layout_delta(layout, base_layout, 0).size() >= encoded_layouts[layout_id].size())
+                continue;
+
+            base_layout_ids[layout_id] = base_layout_id;
+            used_as_base.insert(base_layout_id);
+        }
+    }
+
+    return base_layout_ids;
+}
+
+static std::map<MapLayout*, uint32_t> write_map_layouts(const World& world, md::ROM& rom, const io::WorldWriteOptions& options,
+                                                        io::WorldWriteReport& report)
 {
     // Remove all vanilla map layouts from the ROM
     rom.mark_empty_chunk(offsets::MAP_LAYOUTS_START, offsets::MAP_LAYOUTS_END);
 
+    const std::vector<MapLayout*>& layouts = world.map_layouts();
+
+    // Find layouts which are identical to a previous one (e.g. after cloning a map), so that they can share its data
+    std::vector<uint64_t> layout_hashes(layouts.size());
+    std::vector<size_t> source_layout_ids(layouts.size());
+    std::map<uint64_t, std::vector<size_t>> unique_layout_ids_by_hash;
+    std::vector<size_t> unique_layout_ids;
+    for(size_t i=0 ; i<layouts.size() ; ++i)
+    {
+        layout_hashes[i] = layouts[i]->hash();
+        source_layout_ids[i] = i;
+
+        std::vector<size_t>& candidates = unique_layout_ids_by_hash[layout_hashes[i]];
+        for(size_t candidate_id : candidates)
+        {
+            if(*layouts[candidate_id] == *layouts[i])
+            {
+                source_layout_ids[i] = candidate_id;
+                break;
+            }
+        }
+
+        if(source_layout_ids[i] == i)
+        {
+            candidates.emplace_back(i);
+            unique_layout_ids.emplace_back(i);
+        }
+    }
+
+    // Incrementing runs can only be used if the map loader injected by PatchNewMapFormat handles them
+    bool incrementing_runs = world.map_layouts_incrementing_runs();
+
+    // Layouts which were already encoded by a previous run are taken from the cache if there is one
+    std::vector<ByteArray> encoded_layouts(layouts.size());
+    MapLayoutsCache cache(incrementing_runs);
+    std::vector<size_t> layouts_to_encode;
+    if(!options.map_layouts_cache_path.empty())
+        cache.load_from_file(options.map_layouts_cache_path);
+    for(size_t layout_id : unique_layout_ids)
+    {
+        if(const ByteArray* cached_bytes = cache.find(layout_hashes[layout_id], *layouts[layout_id]))
+            encoded_layouts[layout_id] = *cached_bytes;
+        else
+            layouts_to_encode.emplace_back(layout_id);
+    }
+
+    // Encoding layouts is independent for each layout, so it can be done concurrently. Injection is then done in
+    // the original order since it determines where each layout ends up in the ROM.
+    threadtools::parallel_for(layouts_to_encode.size(), [&](size_t i) {
+        size_t layout_id = layouts_to_encode[i];
+        encoded_layouts[layout_id] = io::encode_map_layout(layouts[layout_id], incrementing_runs);
+    }, options.thread_count);
+
+    // Failing to save the cache only means layouts will be encoded again next time, so it is not an error
+    if(!options.map_layouts_cache_path.empty())
+    {
+        for(size_t layout_id : layouts_to_encode)
+            cache.add(layout_hashes[layout_id], *layouts[layout_id], encoded_layouts[layout_id]);
+        if(cache.modified())
+            cache.save_to_file(options.map_layouts_cache_path);
+    }
+
 //    uint32_t total_size = 0;
 
+    std::map<size_t, size_t> base_layout_ids;
+    if(options.map_layouts_variant_deltas)
+        base_layout_ids = find_delta_map_layouts(world, layouts, source_layout_ids, encoded_layouts);
+
     std::map<MapLayout*, uint32_t> layout_addresses;
 
-    for(MapLayout* layout : world.map_layouts())
+    for(size_t layout_id : unique_layout_ids)
     {
-        ByteArray bytes = io::encode_map_layout(layout);
-//        total_size += bytes.size();
+        if(base_layout_ids.count(layout_id))
+            continue;
+
+//        total_size += encoded_layouts[layout_id].size();
+
+        uint32_t addr = rom.inject_bytes(encoded_layouts[layout_id]);
+        layout_addresses[layouts[layout_id]] = addr;
+    }
+
+    // Delta layouts can only be encoded once the address of their base layout is known
+    for(const auto& [layout_id, base_layout_id] : base_layout_ids)
+    {
+        uint32_t base_layout_addr = layout_addresses.at(layouts[base_layout_id]);
+        ByteArray delta_bytes = io::encode_map_layout_delta(layouts[layout_id], layouts[base_layout_id], base_layout_addr);
+        report.delta_map_layouts++;
+        report.map_layouts_delta_bytes_saved += encoded_layouts[layout_id].size() - delta_bytes.size();
+        encoded_layouts[layout_id] = delta_bytes;
+
+        uint32_t addr = rom.inject_bytes(encoded_layouts[layout_id]);
+        layout_addresses[layouts[layout_id]] = addr;
+    }
 
-        uint32_t addr = rom.inject_bytes(bytes);
-        layout_addresses[layout] = addr;
+    for(size_t i=0 ; i<layouts.size() ; ++i)
+    {
+        size_t source_layout_id = source_layout_ids[i];
+        if(source_layout_id != i)
+        {
+            layout_addresses[layouts[i]] = layout_addresses.at(layouts[source_layout_id]);
+            report.shared_map_layouts++;
+            report.map_layouts_bytes_saved += encoded_layouts[source_layout_id].size();
+        }
     }
 
 //    std::cout << "Full map data for all " << world.map_layouts().size() << " layouts takes " << total_size/1000 << "KB" << std::endl;
@@ -964,21 +1106,25 @@ static void write_maps(const World& world, md::ROM& rom, const std::map<MapLayou
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void io::write_world_to_rom(World& world, md::ROM& rom)
+io::WorldWriteReport io::write_world_to_rom(World& world, md::ROM& rom, const WorldWriteOptions& options)
 {
+    WorldWriteReport report;
+
     world.clean_unused_map_palettes();
     world.clean_unused_blocksets();
     world.clean_unused_layouts();
 
-    std::map<MapLayout*, uint32_t> map_layout_addresses = write_map_layouts(world, rom);
+    std::map<MapLayout*, uint32_t> map_layout_addresses = write_map_layouts(world, rom, options, report);
     write_blocksets(world, rom);
     write_item_names(world, rom);
     write_items(world, rom);
     write_chest_contents(world, rom);
     write_entity_types(world, rom);
     write_entity_type_palettes(world, rom);
-    write_game_strings(world, rom);
+    write_game_strings(world, rom, options);
     write_map_connections(world, rom);
     write_map_palettes(world, rom);
     write_maps(world, rom, map_layout_addresses);
+
+    return report;
 }
\ No newline at end of file
@@ -27,6 +27,8 @@ namespace md {
 
         [[nodiscard]] bool is_valid() const { return _was_open; }
 
+        [[nodiscard]] size_t size() const { return _byte_array.size(); }
+
         [[nodiscard]] uint8_t get_byte(uint32_t address) const { return _byte_array[address]; }
         [[nodiscard]] uint16_t get_word(uint32_t address) const { return (this->get_byte(address) << 8) + this->get_byte(address+1); }
         [[nodiscard]] uint32_t get_long(uint32_t address) const { return (static_cast<uint32_t>(this->get_word(address)) << 16) + static_cast<uint32_t>(this->get_word(address+2)); }
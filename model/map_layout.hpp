@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <array>
 #include <algorithm>
@@ -43,4 +44,40 @@ public:
         _heightmap_size = heightmap_size;
         _heightmap = heightmap;
     }
+
+    bool operator==(const MapLayout& other) const
+    {
+        return _offset == other._offset && _size == other._size && _heightmap_size == other._heightmap_size
+            && _foreground_tiles == other._foreground_tiles && _background_tiles == other._background_tiles
+            && _heightmap == other._heightmap;
+    }
+
+    /**
+     * Computes a FNV-1a hash of everything defining the layout (position, dimensions, tiles and heightmap),
+     * meaning two layouts with the same hash are encoded the same way (barring collisions)
+     */
+    [[nodiscard]] uint64_t hash() const
+    {
+        uint64_t hash = 0xCBF29CE484222325;
+        auto add_byte = [&hash](uint8_t byte) {
+            hash ^= byte;
+            hash *= 0x100000001B3;
+        };
+        auto add_words = [&add_byte](const std::vector<uint16_t>& words) {
+            for(int shift = 24 ; shift >= 0 ; shift -= 8)
+                add_byte((uint8_t)(words.size() >> shift));
+            for(uint16_t word : words)
+            {
+                add_byte((uint8_t)(word >> 8));
+                add_byte((uint8_t)(word & 0xFF));
+            }
+        };
+
+        for(uint8_t byte : { left(), top(), width(), height(), heightmap_width(), heightmap_height() })
+            add_byte(byte);
+        add_words(_foreground_tiles);
+        add_words(_background_tiles);
+        add_words(_heightmap);
+        return hash;
+    }
 };
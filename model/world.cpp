@@ -6,8 +6,14 @@
 #include "blockset.hpp"
 
 #include "../constants/item_codes.hpp"
+#include "../io/io.hpp"
+#include "../io/textbanks_encoding_cache.hpp"
+#include "../tools/threadtools.hpp"
 #include <set>
 
+World::World() = default;
+World::World(World&& other) noexcept = default;
+
 World::~World()
 {
     for (auto& [key, item] : _items)
@@ -188,12 +194,115 @@ uint8_t World::map_palette_id(MapPalette* palette) const
     throw LandstalkerException("Could not find id of MapPalette as it doesn't seem to be in world's map palette list");
 }
 
+StringPool& World::game_strings()
+{
+    this->prefetch_game_strings();
+    _game_strings_fully_dirty = true;
+    return _game_strings;
+}
+
+/**
+ * Gets a game string, decoding it first if game strings are read lazily and this one was not accessed yet.
+ * Since this can edit the strings storage, it is guarded by a mutex to allow concurrent reads on a const World.
+ */
+std::string World::game_string(uint16_t id) const
+{
+    std::lock_guard<std::mutex> lock(*_game_strings_mutex);
+    if(id < _decoded_game_strings.size() && !_decoded_game_strings[id])
+    {
+        const TextbanksEncodingCache& cache = *_textbanks_encoding_cache;
+        _game_strings.set(id, io::decode_encoded_string(cache.encoded_strings[id], cache.trees));
+        _decoded_game_strings[id] = true;
+    }
+    return std::string(_game_strings.at(id));
+}
+
+void World::game_string(uint16_t id, std::string_view value)
+{
+    _game_strings.set(id, value);
+    if(id < _decoded_game_strings.size())
+        _decoded_game_strings[id] = true;
+    _dirty_game_string_ids.insert(id);
+}
+
+/**
+ * Makes game strings decoded on first access from the encoded strings stored in the textbanks encoding cache
+ * instead of being all decoded upfront.
+ */
+void World::defer_game_strings_decoding(size_t string_count)
+{
+    _game_strings.clear();
+    _game_strings.resize(string_count);
+    _decoded_game_strings.assign(string_count, false);
+}
+
+/**
+ * Decodes all game strings which were not accessed yet when game strings are read lazily.
+ */
+void World::prefetch_game_strings(size_t thread_count) const
+{
+    std::lock_guard<std::mutex> lock(*_game_strings_mutex);
+    if(_decoded_game_strings.empty())
+        return;
+
+    std::vector<size_t> ids_to_decode;
+    for(size_t id = 0 ; id < _decoded_game_strings.size() ; ++id)
+        if(!_decoded_game_strings[id])
+            ids_to_decode.emplace_back(id);
+
+    // Strings are decoded concurrently, but need to be added to the pool one at a time
+    const TextbanksEncodingCache& cache = *_textbanks_encoding_cache;
+    std::vector<std::string> decoded_strings(ids_to_decode.size());
+    threadtools::parallel_for(ids_to_decode.size(), [&](size_t i) {
+        decoded_strings[i] = io::decode_encoded_string(cache.encoded_strings[ids_to_decode[i]], cache.trees);
+    }, thread_count);
+    for(size_t i=0 ; i<ids_to_decode.size() ; ++i)
+        _game_strings.set(ids_to_decode[i], decoded_strings[i]);
+    _decoded_game_strings.clear();
+}
+
+/**
+ * @return the ids of game strings edited since they were last read or written, or nullptr if any string could
+ *         have been edited
+ */
+const std::set<uint16_t>* World::dirty_game_string_ids() const
+{
+    if(_game_strings_fully_dirty)
+        return nullptr;
+    return &_dirty_game_string_ids;
+}
+
+void World::clear_dirty_game_strings()
+{
+    _dirty_game_string_ids.clear();
+    _game_strings_fully_dirty = false;
+}
+
+TextbanksEncodingCache& World::textbanks_encoding_cache()
+{
+    if(!_textbanks_encoding_cache)
+        _textbanks_encoding_cache = std::make_unique<TextbanksEncodingCache>();
+    return *_textbanks_encoding_cache;
+}
+
 uint16_t World::first_empty_game_string_id(uint16_t initial_index) const
 {
-    for(size_t i=initial_index ; i<_game_strings.size() ; ++i)
-        if(_game_strings[i].empty())
-            return (uint16_t) i;
-    return _game_strings.size();
+    bool has_undecoded_strings;
+    {
+        std::lock_guard<std::mutex> lock(*_game_strings_mutex);
+        has_undecoded_strings = !_decoded_game_strings.empty();
+    }
+
+    // Strings which were not decoded yet are considered empty by the pool, so they need to be checked one by one
+    if(has_undecoded_strings)
+    {
+        for(size_t i=initial_index ; i<_game_strings.size() ; ++i)
+            if(this->game_string(i).empty())
+                return (uint16_t) i;
+        return _game_strings.size();
+    }
+
+    return _game_strings.first_empty(initial_index);
 }
 
 void World::clean_unused_map_palettes()
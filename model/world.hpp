@@ -5,9 +5,13 @@
 #include "../tools/flag.hpp"
 #include "../tools/json.hpp"
 #include "../tools/color_palette.hpp"
+#include "../tools/string_pool.hpp"
 #include "map_layout.hpp"
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <vector>
 
 class SpawnLocation;
@@ -17,13 +21,25 @@ class WorldTeleportTree;
 class EntityType;
 class Map;
 class Blockset;
+struct TextbanksEncodingCache;
 
 // TODO: Make const accessors which return const pointers (ensuring there is no edition whatsoever)
 class World
 {
 private:
     std::map<uint8_t, Item*> _items;
-    std::vector<std::string> _game_strings;
+    mutable StringPool _game_strings;
+    /// When game strings are read lazily, tells for each string if it was already decoded (empty if all are)
+    mutable std::vector<bool> _decoded_game_strings;
+    /// Guards lazy decoding of game strings, which edits the two members above from const accessors.
+    /// Held through a pointer so that a World can still be moved.
+    std::unique_ptr<std::mutex> _game_strings_mutex = std::make_unique<std::mutex>();
+    /// Ids of game strings edited through `game_string(id, value)` since strings were last read or written
+    std::set<uint16_t> _dirty_game_string_ids;
+    /// True if game strings could have been edited in any way (e.g. through mutable `game_strings()`)
+    bool _game_strings_fully_dirty = true;
+    /// Encoding of game strings as they were last read or written, so that only edited strings need to be encoded again
+    std::unique_ptr<TextbanksEncodingCache> _textbanks_encoding_cache;
     std::map<uint8_t, EntityType*> _entity_types;
     std::map<uint16_t, Map*> _maps;
     std::vector<MapConnection> _map_connections;
@@ -43,9 +59,13 @@ private:
 
     /// Requires PatchImproveLanternHandling to be handled
     std::vector<uint16_t> _dark_maps;
+    /// Set by PatchNewMapFormat when its loader handles "incrementing run" commands, which makes map layouts
+    /// be encoded using them
+    bool _map_layouts_incrementing_runs = false;
 
 public:
-    World() = default;
+    World();
+    World(World&& other) noexcept;
     ~World();
 
     [[nodiscard]] const std::map<uint8_t, Item*>& items() const { return _items; }
@@ -56,13 +76,46 @@ public:
     Item* add_gold_item(uint8_t worth);
     [[nodiscard]] std::vector<Item*> starting_inventory() const;
 
-    [[nodiscard]] const std::vector<std::string>& game_strings() const { return _game_strings; }
-    std::vector<std::string>& game_strings() { return _game_strings; }
+    /**
+     * Strings read from this pool are views which are invalidated by any later edition of game strings (through
+     * `game_string(id, value)` or the mutable `game_strings()`), copy them if they need to outlive such an edition.
+     */
+    [[nodiscard]] const StringPool& game_strings() const { this->prefetch_game_strings(); return _game_strings; }
+    /**
+     * Strings can be edited with `game_strings()[id] = value` as before, but calling this overload flags all strings
+     * as edited (even if they are only read), which means they all need to be compared and encoded again when writing
+     * the ROM. Prefer `game_string(id, value)` for single edits, and `std::as_const(world).game_strings()` to only read
+     * strings from a non-const World.
+     * Same as for the const overload, views read from this pool are invalidated by any later edition.
+     */
+    StringPool& game_strings();
+    /**
+     * When game strings are read lazily, this const accessor decodes the requested string and stores it. This is
+     * guarded by a mutex, so a const World can be read from several threads at once, but not while being edited.
+     */
+    [[nodiscard]] std::string game_string(uint16_t id) const;
+    void game_string(uint16_t id, std::string_view value);
+    void defer_game_strings_decoding(size_t string_count);
+    /// Decodes all strings not decoded yet, under the same mutex as `game_string(id)` (see above)
+    void prefetch_game_strings(size_t thread_count = 0) const;
+    /**
+     * Game strings as they are stored, without decoding the ones which were read lazily and never accessed: those
+     * are empty, and flagged as such in `decoded_game_strings()` (empty if all strings are decoded).
+     * Unlike other const accessors, these are not guarded by a mutex.
+     */
+    [[nodiscard]] const StringPool& stored_game_strings() const { return _game_strings; }
+    [[nodiscard]] const std::vector<bool>& decoded_game_strings() const { return _decoded_game_strings; }
+    [[nodiscard]] const std::set<uint16_t>* dirty_game_string_ids() const;
+    void clear_dirty_game_strings();
+    TextbanksEncodingCache& textbanks_encoding_cache();
     [[nodiscard]] uint16_t first_empty_game_string_id(uint16_t initial_index = 0) const;
 
     [[nodiscard]] const std::vector<uint16_t>& dark_maps() const { return _dark_maps; }
     void dark_maps(const std::vector<uint16_t>& dark_maps) { _dark_maps = dark_maps; }
 
+    [[nodiscard]] bool map_layouts_incrementing_runs() const { return _map_layouts_incrementing_runs; }
+    void map_layouts_incrementing_runs(bool value) { _map_layouts_incrementing_runs = value; }
+
     [[nodiscard]] uint16_t spawn_map_id() const { return _spawn_map_id; }
     void spawn_map_id(uint16_t value) { _spawn_map_id = value; }
 
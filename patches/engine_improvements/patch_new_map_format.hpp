@@ -2,10 +2,23 @@
 
 /**
  * This patch enables handling of the new map layout encoding which is much more simple than the one from vanilla game.
+ * Layouts can also be stored as tile patches to apply on top of another layout (see io::encode_map_layout_delta).
+ * If `incrementing_runs` is set, the loader also handles "incrementing run" commands, and the World is flagged so that
+ * map layouts get encoded using them (see World::map_layouts_incrementing_runs).
  */
 class PatchNewMapFormat : public GamePatch
 {
+private:
+    bool _incrementing_runs = false;
+
 public:
+    explicit PatchNewMapFormat(bool incrementing_runs = false) : _incrementing_runs(incrementing_runs) {}
+
+    void alter_world(World& world) override
+    {
+        world.map_layouts_incrementing_runs(_incrementing_runs);
+    }
+
     void clear_space_in_rom(md::ROM& rom) override
     {
         rom.mark_empty_chunk(0x2BCE, 0x2CA2); // GetTilemap & ExtractMap functions
@@ -15,9 +28,11 @@ public:
     void inject_code(md::ROM& rom, World& world) override
     {
         uint32_t func_clear_map_data = inject_func_clear_map_data(rom);
-        uint32_t func_load_data_block = inject_func_load_data_block(rom);
+        uint32_t func_load_data_block = inject_func_load_data_block(rom, _incrementing_runs);
+
+        uint32_t func_apply_delta_patches = inject_func_apply_delta_patches(rom);
 
-        uint32_t func_load_map = inject_func_load_map(rom, func_load_data_block, func_clear_map_data);
+        uint32_t func_load_map = inject_func_load_map(rom, func_load_data_block, func_clear_map_data, func_apply_delta_patches);
         rom.set_code(0x2BC8, md::Code().jmp(func_load_map));
     }
 
@@ -87,10 +102,13 @@ private:
      * A0 = data to copy
      * A1 = block where to copy data
      *
+     * Once the first line is reached, D1 is reused as the value added to the repeated word after each write, which
+     * is only non-zero for incrementing runs.
+     *
      * @param rom
-     * @param world
+     * @param incrementing_runs true to handle "1100WWWW WWWWWWXX" incrementing run commands
      */
-    static uint32_t inject_func_load_data_block(md::ROM& rom)
+    static uint32_t inject_func_load_data_block(md::ROM& rom, bool incrementing_runs)
     {
         md::Code func;
         func.movem_to_stack({ reg_D0_D7 }, { reg_A3 });
@@ -144,6 +162,8 @@ private:
         {
             func.subqw(1, reg_D4);
             func.movew(reg_D6, addr_postinc_(reg_A1));
+            if(incrementing_runs)
+                func.addw(reg_D1, reg_D6);
             func.bra("next_loop_iteration");
         }
 
@@ -151,6 +171,8 @@ private:
         // Code block handling the case where the msb is set
         func.label("minus_case");
         {
+            if(incrementing_runs)
+                func.moveq(0, reg_D1); // Only incrementing runs change the repeated word between writes
             func.andiw(0x7FFF, reg_D7); // Remove the topmost bit which is always set
             func.beq("ret");            // "10000000 00000000" case: end of block
 
@@ -171,6 +193,11 @@ private:
             func.beq("init_repeat_inverted_word");  // 5 --> 20744 usages
             func.cmpib(6, reg_D7);
             func.beq("init_repeat_small_word");     // 6 --> 16096 usages
+            if(incrementing_runs)
+            {
+                func.cmpib(4, reg_D7);
+                func.beq("init_incrementing_run");
+            }
             func.bra("init_repeat_word");           // 3 --> 114 usages
             //func.cmpib(3, reg_D7);
             //func.beq("init_repeat_word");
@@ -235,7 +262,24 @@ private:
         }
 
         // -----------------------------------------------
-        // 4 -> "1001AAAA AABBBBBB" case: place byte A then byte B as words
+        // 4 -> "1100WWWW WWWWWWXX" case: place word W 2+X times, incrementing it on every write
+        if(incrementing_runs)
+        {
+            func.label("init_incrementing_run");
+            {
+                // Setup amount of repeats (D4)
+                func.movew(reg_D6, reg_D4);
+                func.andiw(0x0003, reg_D4);
+                func.addqb(2, reg_D4);
+                // Setup first word (D6) and increment (D1)
+                func.lsrw(2, reg_D6);
+                func.moveq(1, reg_D1);
+                func.bra("repeat");     // Start the repeat loop
+            }
+        }
+
+        // -----------------------------------------------
+        // 1 -> "1001AAAA AABBBBBB" case: place byte A then byte B as words
         func.label("unpack_bytes");
         {
             func.movew(reg_D6, reg_D7);
@@ -251,21 +295,56 @@ private:
         return rom.inject_code(func);
     }
 
+    /**
+     * Writes words from a list of (offset, value) patches at A0 inside the block at A1, until a 0xFFFF offset is found.
+     * Offsets are in bytes from the block start.
+     *
+     * @param rom
+     * @return
+     */
+    static uint32_t inject_func_apply_delta_patches(md::ROM& rom)
+    {
+        md::Code func;
+        func.label("loop");
+        {
+            func.movew(addr_postinc_(reg_A0), reg_D0);
+            func.bmi("ret");
+            func.movew(addr_postinc_(reg_A0), addrw_(reg_A1, reg_D0));
+        }
+        func.bra("loop");
+        func.label("ret");
+        func.rts();
+
+        return rom.inject_code(func);
+    }
+
     /**
      * A2 = address of the map layout to load
      *
+     * A delta layout (starting with 0xFF) is loaded by loading the full layout it is based on, then applying its
+     * patches on top of it.
+     *
      * @param rom
      * @param func_load_data_block
-     * @param func_set_longs
+     * @param func_clear_map_data
+     * @param func_apply_delta_patches
      * @return
      */
-    static uint32_t inject_func_load_map(md::ROM& rom, uint32_t func_load_data_block, uint32_t func_clear_map_data)
+    static uint32_t inject_func_load_map(md::ROM& rom, uint32_t func_load_data_block, uint32_t func_clear_map_data,
+                                         uint32_t func_apply_delta_patches)
     {
         md::Code func_load_map;
-        func_load_map.movem_to_stack({ reg_D0_D7 }, { reg_A0, reg_A1 });
+        func_load_map.movem_to_stack({ reg_D0_D7 }, { reg_A0, reg_A1, reg_A2, reg_A3 });
         {
             func_load_map.jsr(func_clear_map_data);
 
+            // Store the layout address inside A3, and make A2 point on the base layout if this is a delta layout
+            func_load_map.movel(reg_A2, reg_A3);
+            func_load_map.cmpib(0xFF, addr_(reg_A2));
+            func_load_map.bne("full_layout");
+            func_load_map.movel(addr_(reg_A2, 2), reg_A2);
+            func_load_map.label("full_layout");
+
             // --------------------------------------------------------------------------------------------------------
 
             // Read metadata for tiles
@@ -302,8 +381,22 @@ private:
             // Copy heightmap
             func_load_map.lea(0xFFD192, reg_A1);
             func_load_map.jsr(func_load_data_block);
+
+            // --------------------------------------------------------------------------------------------------------
+
+            // Apply delta patches on top of the base layout, if any
+            func_load_map.cmpa(reg_A2, reg_A3);
+            func_load_map.beq("ret");
+            func_load_map.lea(addr_(reg_A3, 6), reg_A0);
+            func_load_map.lea(0xFF7C02, reg_A1);
+            func_load_map.jsr(func_apply_delta_patches);
+            func_load_map.lea(0xFFA6CA, reg_A1);
+            func_load_map.jsr(func_apply_delta_patches);
+            func_load_map.lea(0xFFD192, reg_A1);
+            func_load_map.jsr(func_apply_delta_patches);
         }
-        func_load_map.movem_from_stack({ reg_D0_D7 }, { reg_A0, reg_A1 });
+        func_load_map.label("ret");
+        func_load_map.movem_from_stack({ reg_D0_D7 }, { reg_A0, reg_A1, reg_A2, reg_A3 });
         func_load_map.rts();
 
         return rom.inject_code(func_load_map);
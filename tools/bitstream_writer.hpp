@@ -1,12 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <map>
 #include <vector>
 #include "../exceptions.hpp"
 
 class BitstreamWriter {
 private:
+    /// Bytes written so far, including the current partial byte (zero-padded) if there is one
     std::vector<uint8_t> _bytes;
-    int8_t _bit_position = 8;
+    /// Bits of the current partial byte, right-aligned
+    uint64_t _pending_bits = 0;
+    uint8_t _pending_bit_count = 0;
 
 public:
     BitstreamWriter() = default;
@@ -15,16 +21,7 @@ public:
 
     void add_bit(bool bit)
     {
-        if(_bit_position == 8)
-        {
-            _bytes.emplace_back(0);
-            _bit_position = 0;
-        }
-
-        uint8_t& last_byte = _bytes[_bytes.size()-1];
-        uint8_t base_value = (bit) ? 1 : 0;
-        last_byte |= (base_value << (7 - _bit_position));
-        _bit_position += 1;
+        this->add_number(bit ? 1 : 0, 1);
     }
 
     void add_bits(const std::vector<bool>& bits)
@@ -33,16 +30,41 @@ public:
             this->add_bit(bit);
     }
 
-    void add_number(uint32_t value, int num_bits)
+    /**
+     * Adds the `num_bits` lowest bits of `value` (most significant first). Bits are accumulated in a 64-bit register
+     * with the pending bits of the partial byte, and only whole bytes are flushed to the stream.
+     */
+    void add_number(uint64_t value, int num_bits)
     {
-        for(int bit = num_bits-1 ; bit >= 0 ; --bit)
-            this->add_bit(value & (1 << bit));
+        // The partial byte is rewritten once new bits were appended to it
+        if(_pending_bit_count > 0)
+            _bytes.pop_back();
+
+        while(num_bits > 0)
+        {
+            // Less than 8 bits are pending, so taking at most 56 new bits never overflows the register
+            int taken_bits = std::min(num_bits, 56);
+            num_bits -= taken_bits;
+            _pending_bits = (_pending_bits << taken_bits) | ((value >> num_bits) & ((1ULL << taken_bits) - 1));
+            _pending_bit_count += taken_bits;
+
+            while(_pending_bit_count >= 8)
+            {
+                _pending_bit_count -= 8;
+                _bytes.emplace_back((uint8_t)(_pending_bits >> _pending_bit_count));
+            }
+            _pending_bits &= (1ULL << _pending_bit_count) - 1;
+        }
+
+        if(_pending_bit_count > 0)
+            _bytes.emplace_back((uint8_t)(_pending_bits << (8 - _pending_bit_count)));
     }
 
     void skip_byte_remainder()
     {
-        if(_bit_position != 0)
-            _bit_position = 8;
+        // The partial byte is already stored zero-padded, it only needs to stop receiving bits
+        _pending_bits = 0;
+        _pending_bit_count = 0;
     }
 
     void add_variable_length_number(uint32_t number)
@@ -55,9 +77,8 @@ public:
         }
         uint32_t mantissa = number + 1 - (1 << exponent);
 
-        for(uint16_t i=0 ; i<exponent ; ++i)
-            this->add_bit(false);
-        this->add_bit(true);
+        // `exponent` zeros followed by a one
+        this->add_number(1, exponent + 1);
         this->add_number(mantissa, exponent);
     }
 
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
 class ByteArray : public std::vector<uint8_t>
 {
@@ -11,9 +11,7 @@ GameText::GameText(const std::string& text, uint8_t lines_in_textbox) :
 GameText::GameText(const std::string& text, const std::string& name, uint8_t lines_in_textbox) :
     _lines_in_textbox(lines_in_textbox)
 {
-    std::string full_name = name + ": ";
-    for(char c : full_name)
-        _current_line_length += character_width(c);
+    _current_line_length = name_width(name);
 
     if(!name.empty())
         this->text("\u001c" + text);
@@ -24,10 +22,55 @@ GameText::GameText(const std::string& text, const std::string& name, uint8_t lin
 void GameText::text(const std::string& text)
 {
     _initial_text = text;
-    _output_text = "";
+    this->layout(text);
+}
+
+/**
+ * Lays out the whole text in a single pass: each word width is computed once when reaching the word, then the word
+ * is copied in chunks, only breaking it if it does not fit on a single line.
+ */
+void GameText::layout(std::string_view text)
+{
+    _output_text.clear();
+    // Most texts only add a few line breaks and textbox breaks to the input
+    _output_text.reserve(text.size() + (text.size() / 16) + 2);
+
+    size_t i = 0;
+    while (i < text.size())
+    {
+        char character = text[i];
+        if (character == ' ')
+        {
+            this->add_character(character);
+            ++i;
+            continue;
+        }
+
+        // If we start a new word, check if we can finish it on the same line
+        uint16_t width = word_width(text, i);
+        if (!_output_text.empty() && _output_text.back() == ' ' && _current_line_length + width >= LINE_SIZE_PIXELS)
+            this->new_line();
+
+        if (character == '\n')
+        {
+            this->new_line();
+            ++i;
+            continue;
+        }
 
-    for (size_t i = 0; i < text.size(); ++i)
-        this->add_character(text, i);
+        size_t chunk_start = i;
+        for ( ; i < text.size() && text[i] != ' ' && text[i] != '\n' ; ++i)
+        {
+            if (_current_line_length >= LINE_SIZE_PIXELS)
+            {
+                _output_text.append(text, chunk_start, i - chunk_start);
+                this->new_line();
+                chunk_start = i;
+            }
+            _current_line_length += character_width(text[i]);
+        }
+        _output_text.append(text, chunk_start, i - chunk_start);
+    }
 
     _output_text += "\x03"; // EOL
 }
@@ -37,19 +80,11 @@ void GameText::add_character(const std::string& text, size_t i)
     char character = text[i];
 
     // If we start a new word, check if we can finish it on the same line
-    if (!_output_text.empty() && character != ' ' && (*_output_text.rbegin()) == ' ')
+    if (!_output_text.empty() && character != ' ' && _output_text.back() == ' ')
     {
-        uint16_t word_width = 0;
-        char current_word_char = character;
-        while (current_word_char != '\n' && current_word_char != ' ' && current_word_char != '\0')
-        {
-            word_width += character_width(current_word_char);
-            current_word_char = text[++i];
-        }
-
         // Word is too big to fit on the line, skip a line
-        if (_current_line_length + word_width >= LINE_SIZE_PIXELS)
-            this->add_character('\n');
+        if (_current_line_length + word_width(text, i) >= LINE_SIZE_PIXELS)
+            this->new_line();
     }
 
     this->add_character(character);
@@ -58,120 +93,95 @@ void GameText::add_character(const std::string& text, size_t i)
 void GameText::add_character(char character)
 {
     if (character == '\n')
-    {
-        _current_line_length = 0;
-        if (*_output_text.rbegin() == ' ')
-            _output_text = _output_text.substr(0, _output_text.size() - 1);
+        this->new_line();
+    else
+        this->append_character(character);
+}
 
-        if (++_current_line_count == _lines_in_textbox)
-        {
-            _output_text += "\x1E";
-            _current_line_count = 0;
-        }
-        _output_text += "\x0A";
+void GameText::new_line()
+{
+    _current_line_length = 0;
+    if (!_output_text.empty() && _output_text.back() == ' ')
+        _output_text.pop_back();
 
-        return;
-    } 
-    
-    if (_current_line_length >= LINE_SIZE_PIXELS)
+    if (++_current_line_count == _lines_in_textbox)
     {
-        this->add_character('\n');
-
-        uint8_t previous_byte = *_output_text.rbegin();
-        bool needs_hyphen = (previous_byte >= 'A' && previous_byte <= 'z');
-        if (needs_hyphen)
-            this->add_character('-');
+        _output_text += "\x1E";
+        _current_line_count = 0;
     }
+    _output_text += "\x0A";
+}
+
+void GameText::append_character(char character)
+{
+    if (_current_line_length >= LINE_SIZE_PIXELS)
+        this->new_line();
 
     _output_text += character;
     _current_line_length += character_width(character);
 }
 
-uint8_t GameText::character_width(char character)
+/**
+ * Computes the width of the word starting at `i`, which ends on the next space or line break
+ */
+uint16_t GameText::word_width(std::string_view text, size_t i)
+{
+    uint16_t width = 0;
+    for ( ; i < text.size() && text[i] != '\n' && text[i] != ' ' && text[i] != '\0' ; ++i)
+        width += character_width(text[i]);
+    return width;
+}
+
+uint16_t GameText::name_width(const std::string& name)
+{
+    uint16_t width = 0;
+    for(char c : name + ": ")
+        width += character_width(c);
+    return width;
+}
+
+/**
+ * Lays out a text from a batch, resetting state from the previously laid out text
+ */
+std::string GameText::layout_batch_text(const std::string& text, const std::string& name, uint8_t lines_in_textbox)
 {
-    switch (character)
+    _lines_in_textbox = lines_in_textbox;
+    _current_line_count = 0;
+    if (name.empty())
     {
-    case ' ':    return 8;
-    case '0':    return 8;
-        //        case '1':    return 8;
-    case '2':    return 8;
-        //        case '3':    return 8;
-        //        case '4':    return 8;
-        //        case '5':    return 8;
-        //        case '6':    return 8;
-        //        case '7':    return 8;
-        //        case '8':    return 8;
-        //        case '9':    return 8;
-    case 'A':    return 8;
-    case 'B':    return 8;
-        //        case 'C':    return 8;
-    case 'D':    return 8;
-    case 'E':    return 8;
-    case 'F':    return 8;
-        //        case 'G':    return 8;
-        //        case 'H':    return 8;
-    case 'I':    return 5;
-        //        case 'J':    return 8;
-        //        case 'K':    return 8;
-        //        case 'L':    return 8;
-        //        case 'M':    return 8;
-        //        case 'N':    return 8;
-    case 'O':    return 8;
-        //        case 'P':    return 8;
-        //        case 'Q':    return 8;
-        //        case 'R':    return 8;
-        //        case 'S':    return 8;
-    case 'T':    return 9;
-        //        case 'U':    return 8;
-        //        case 'V':    return 8;
-        //        case 'W':    return 8;
-        //        case 'X':    return 8;
-    case 'Y':    return 8;
-        //        case 'Z':    return 8;
-    case 'a':    return 9;
-    case 'b':    return 8;
-    case 'c':    return 8;
-    case 'd':    return 8;
-    case 'e':    return 8;
-    case 'f':    return 7;
-    case 'g':    return 8;
-    case 'h':    return 8;
-    case 'i':    return 5;
-    case 'j':    return 6;
-    case 'k':    return 8;
-    case 'l':    return 6;
-    case 'm':    return 10;
-    case 'n':    return 8;
-    case 'o':    return 8;
-    case 'p':    return 8;
-        //        case 'q':    return 8;
-    case 'r':    return 8;
-    case 's':    return 8;
-    case 't':    return 8;
-    case 'u':    return 8;
-    case 'v':    return 9;
-    case 'w':    return 11;
-    case 'x':    return 8;
-    case 'y':    return 8;
-        //        case 'z':    return 8;
-    case '*':    return 9;
-    case '.':    return 5;
-    case ',':    return 5;
-    case '?':    return 8;
-    case '!':    return 5;
-        //        case '/':    return 8;
-        //        case '<':    return 8;
-        //        case '>':    return 8;
-    case ':':    return 4;
-        //        case '-':    return 8;
-    case '\'':    return 4;
-        //        case '"':    return 8;
-        //        case '%':    return 8;
-        //        case '#':    return 8;
-        //        case '&':    return 8;
-        //        case '(':    return 8;
-        //        case ')':    return 8;
-        //        case '=':    return 8;
-    default:    return 8;
+        _current_line_length = 0;
+        this->layout(text);
+    }
+    else
+    {
+        _current_line_length = name_width(name);
+        // Initial text is never read back from the GameText used for batches, so it is reused as a buffer
+        _initial_text.assign("\u001c");
+        _initial_text += text;
+        this->layout(_initial_text);
     }
+    return std::move(_output_text);
+}
+
+std::vector<std::string> GameText::layout_texts(const std::vector<GameTextLayoutRequest>& requests)
+{
+    std::vector<std::string> outputs;
+    outputs.reserve(requests.size());
+
+    // A single GameText is reused for all texts, and outputs are directly moved out of it
+    GameText game_text;
+    for (const GameTextLayoutRequest& request : requests)
+        outputs.emplace_back(game_text.layout_batch_text(request.text, request.name, request.lines_in_textbox));
+    return outputs;
+}
+
+std::vector<std::string> GameText::layout_texts(const std::vector<std::string>& texts, uint8_t lines_in_textbox)
+{
+    std::vector<std::string> outputs;
+    outputs.reserve(texts.size());
+
+    GameText game_text;
+    for (const std::string& text : texts)
+        outputs.emplace_back(game_text.layout_batch_text(text, "", lines_in_textbox));
+    return outputs;
 }
@@ -1,9 +1,51 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 
+constexpr std::array<uint8_t, 256> build_game_text_character_widths()
+{
+    // Characters are 8 pixels wide unless stated otherwise
+    std::array<uint8_t, 256> widths {};
+    for(uint8_t& width : widths)
+        width = 8;
+
+    widths['I'] = 5;
+    widths['T'] = 9;
+    widths['a'] = 9;
+    widths['f'] = 7;
+    widths['i'] = 5;
+    widths['j'] = 6;
+    widths['l'] = 6;
+    widths['m'] = 10;
+    widths['v'] = 9;
+    widths['w'] = 11;
+    widths['*'] = 9;
+    widths['.'] = 5;
+    widths[','] = 5;
+    widths['!'] = 5;
+    widths[':'] = 4;
+    widths['\''] = 4;
+    return widths;
+}
+
+/// Width in pixels of each character when displayed in a textbox
+constexpr std::array<uint8_t, 256> GAME_TEXT_CHARACTER_WIDTHS = build_game_text_character_widths();
+
+/**
+ * A text to lay out using GameText::layout_texts. If `name` is not empty, the text is said by this character
+ * (as in the GameText constructor taking a name).
+ */
+struct GameTextLayoutRequest
+{
+    std::string text;
+    std::string name;
+    uint8_t lines_in_textbox = 3;
+};
+
 class GameText
 {
 private:
@@ -26,5 +68,17 @@ public:
 
     [[nodiscard]] const std::string& get_output() const { return _output_text; }
 
-    static uint8_t character_width(char character);
-};
\ No newline at end of file
+    static std::vector<std::string> layout_texts(const std::vector<GameTextLayoutRequest>& requests);
+    static std::vector<std::string> layout_texts(const std::vector<std::string>& texts, uint8_t lines_in_textbox = 3);
+
+    static constexpr uint8_t character_width(char character) { return GAME_TEXT_CHARACTER_WIDTHS[(uint8_t)character]; }
+
+private:
+    void layout(std::string_view text);
+    std::string layout_batch_text(const std::string& text, const std::string& name, uint8_t lines_in_textbox);
+    void new_line();
+    void append_character(char character);
+
+    static uint16_t word_width(std::string_view text, size_t i);
+    static uint16_t name_width(const std::string& name);
+};
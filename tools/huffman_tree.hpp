@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <algorithm>
+#include <array>
+#include <vector>
 
 #include "huffman_tree_node.hpp"
 #include "../constants/symbols.hpp"
@@ -9,97 +11,243 @@
 #include "bitstream_reader.hpp"
 #include "bitstream_writer.hpp"
 
+/**
+ * An entry of a HuffmanTree decoding table, which is either a leaf (symbol decoded using `length` bits of the
+ * current table level) or a link to a subtable (starting at index `value` and indexed by `length` bits).
+ */
+struct HuffmanDecodingTableEntry {
+    uint16_t value = 0;
+    uint8_t length = 0;
+    bool is_link = false;
+};
+
+/**
+ * The code used to encode a symbol, stored as its `length` lowest bits in `bits` (first bit is the most significant)
+ */
+struct HuffmanCode {
+    uint64_t bits = 0;
+    uint8_t length = 0;
+    bool exists = false;
+};
+
 class HuffmanTree
 {
+public:
+    static constexpr uint8_t DECODING_TABLE_ROOT_BITS = 9;
+    static constexpr uint8_t DECODING_SUBTABLE_BITS = 6;
+
+    static constexpr uint16_t ROOT_NODE = 0;
+    static constexpr uint8_t MAX_OPTIMAL_CODE_LENGTH = 32;
+
 private:
-    HuffmanTreeNode* _root_node;
-    std::map<uint8_t, std::vector<bool>> _encodingTable;
+    std::vector<HuffmanTreeNode> _nodes;
+    std::array<HuffmanCode, SYMBOL_COUNT> _codes {};
+    std::vector<HuffmanDecodingTableEntry> _decoding_table;
+    uint8_t _decoding_table_root_bits = 0;
 
 public:
     // Constructor to build a Huffman tree from ROM data
-    HuffmanTree() : _root_node(new HuffmanTreeNode())
+    HuffmanTree() : _nodes(1)
     {}
 
-    // Constructor to build a Huffman tree from a list of symbol counts
-    explicit HuffmanTree(const std::vector<SymbolCount>& successor_counts)
+    /**
+     * Constructor to build a Huffman tree from a list of symbol counts sorted by decreasing count.
+     * @param optimal if false, the tree is built by recursively splitting symbols at the weight median (which is how
+     *        the original game trees were built). If true, an optimal prefix code limited to MAX_OPTIMAL_CODE_LENGTH
+     *        bits is computed using the package-merge algorithm, which produces smaller encoded strings.
+     */
+    explicit HuffmanTree(const std::vector<SymbolCount>& successor_counts, bool optimal = false)
     {
-        _root_node = new HuffmanTreeNode();
-        this->build_nodes_from_array(_root_node, successor_counts);
-        this->build_encoding_table(_root_node);
+        // A full binary tree with N leaves always has 2N-1 nodes
+        _nodes.reserve((successor_counts.size() * 2) - 1);
+        _nodes.emplace_back();
+        if(optimal)
+            this->build_nodes_from_code_lengths(successor_counts, compute_optimal_code_lengths(successor_counts, MAX_OPTIMAL_CODE_LENGTH));
+        else
+            this->build_nodes_from_range(ROOT_NODE, successor_counts, 0, successor_counts.size());
+        this->build_encoding_table();
+        // Strings read lazily can be decoded with trees built when writing them, so these need a decoding table too
+        this->build_decoding_table();
     }
 
-    ~HuffmanTree()
+    [[nodiscard]] const HuffmanTreeNode& node(uint16_t index) const { return _nodes[index]; }
+    [[nodiscard]] HuffmanTreeNode& node(uint16_t index) { return _nodes[index]; }
+    [[nodiscard]] size_t node_count() const { return _nodes.size(); }
+
+    uint16_t add_left_child(uint16_t parent)
     {
-        delete _root_node;
+        uint16_t child = this->add_node(parent);
+        _nodes[parent].left_child(child);
+        return child;
     }
 
-    [[nodiscard]] HuffmanTreeNode* root_node() const { return _root_node; }
+    uint16_t add_right_child(uint16_t parent)
+    {
+        uint16_t child = this->add_node(parent);
+        _nodes[parent].right_child(child);
+        return child;
+    }
 
-    void build_nodes_from_array(HuffmanTreeNode* fromNode, const std::vector<SymbolCount>& successor_counts)
+    /**
+     * Builds the subtree below `from_node` for symbols of `successor_counts` in range [begin, end).
+     */
+    void build_nodes_from_range(uint16_t from_node, const std::vector<SymbolCount>& successor_counts, size_t begin, size_t end)
     {
-        if (successor_counts.size() < 2)
+        if (end - begin < 2)
         {
             // Leaf node
-            fromNode->symbol(successor_counts[0].symbol());
+            _nodes[from_node].symbol(successor_counts[begin].symbol());
             return;
         }
 
         // Branch node: find which index is the median in terms of commonness, to then be able to
         // split evenly between the left and right branches
         uint32_t half_weight_sum = 0;
-        for (const SymbolCount& sc : successor_counts)
-            half_weight_sum += sc.count();
+        for (size_t i = begin ; i < end ; ++i)
+            half_weight_sum += successor_counts[i].count();
         half_weight_sum /= 2;
 
         uint32_t current_weight_sum = 0;
-        auto it = successor_counts.begin();
-        while(current_weight_sum < half_weight_sum && it != successor_counts.end())
+        size_t split = begin;
+        while(current_weight_sum < half_weight_sum && split != end)
         {
-            current_weight_sum += it->count();
-            ++it;
+            current_weight_sum += successor_counts[split].count();
+            ++split;
         }
 
-        std::vector<SymbolCount> leftSide(successor_counts.begin(), it);
-        std::vector<SymbolCount> rightSide(it, successor_counts.end());
+        uint16_t left_child = this->add_left_child(from_node);
+        uint16_t right_child = this->add_right_child(from_node);
+        this->build_nodes_from_range(left_child, successor_counts, begin, split);
+        this->build_nodes_from_range(right_child, successor_counts, split, end);
+    }
+
+    /**
+     * Computes the optimal code length for each symbol under a maximum code length, using the package-merge
+     * algorithm: each symbol is a coin of value 2^-length, and we look for the cheapest set of coins summing to N-1.
+     * @return the code length for each symbol, in the same order as `symbol_counts`
+     */
+    static std::vector<uint8_t> compute_optimal_code_lengths(const std::vector<SymbolCount>& symbol_counts, uint8_t max_length)
+    {
+        const size_t symbol_count = symbol_counts.size();
+        std::vector<uint8_t> code_lengths(symbol_count, 0);
+        if(symbol_count < 2)
+            return code_lengths;
+        if((symbol_count - 1) >> max_length)
+            throw LandstalkerException("Too many symbols to build a Huffman tree with such a maximum code length");
+
+        // An item is either a single symbol or a package of two items from the previous level, and keeps
+        // track of how many times each symbol appears inside it
+        struct Item {
+            uint64_t weight = 0;
+            std::vector<uint8_t> symbol_occurrences;
+        };
+
+        std::vector<Item> leaves;
+        leaves.reserve(symbol_count);
+        for(size_t i=0 ; i<symbol_count ; ++i)
+        {
+            Item& leaf = leaves.emplace_back();
+            leaf.weight = symbol_counts[i].count();
+            leaf.symbol_occurrences.resize(symbol_count, 0);
+            leaf.symbol_occurrences[i] = 1;
+        }
+        std::stable_sort(leaves.begin(), leaves.end(), [](const Item& a, const Item& b) { return a.weight < b.weight; });
 
-        fromNode->left_child(new HuffmanTreeNode());
-        fromNode->right_child(new HuffmanTreeNode());
-        this->build_nodes_from_array(fromNode->left_child(), leftSide);
-        this->build_nodes_from_array(fromNode->right_child(), rightSide);
+        std::vector<Item> items = leaves;
+        for(uint8_t level = 1 ; level < max_length ; ++level)
+        {
+            std::vector<Item> packages;
+            packages.reserve(items.size() / 2);
+            for(size_t i=0 ; i+1 < items.size() ; i += 2)
+            {
+                Item& package = packages.emplace_back();
+                package.weight = items[i].weight + items[i+1].weight;
+                package.symbol_occurrences = items[i].symbol_occurrences;
+                for(size_t j=0 ; j<symbol_count ; ++j)
+                    package.symbol_occurrences[j] += items[i+1].symbol_occurrences[j];
+            }
+
+            items.clear();
+            std::merge(leaves.begin(), leaves.end(), packages.begin(), packages.end(), std::back_inserter(items),
+                       [](const Item& a, const Item& b) { return a.weight < b.weight; });
+        }
+
+        // The code length of a symbol is the number of times it appears in the 2N-2 cheapest items
+        for(size_t i=0 ; i < (symbol_count * 2) - 2 ; ++i)
+            for(size_t j=0 ; j<symbol_count ; ++j)
+                code_lengths[j] += items[i].symbol_occurrences[j];
+
+        return code_lengths;
+    }
+
+    /**
+     * Compiles the tree into a multi-level decoding table, so that a symbol can be decoded by peeking
+     * at several bits at once instead of walking the tree one bit at a time. Codes no longer than
+     * DECODING_TABLE_ROOT_BITS are decoded in one read, longer ones go through chained subtables.
+     */
+    void build_decoding_table()
+    {
+        _decoding_table.clear();
+        _decoding_table_root_bits = std::min(DECODING_TABLE_ROOT_BITS, this->max_depth(ROOT_NODE));
+        this->build_decoding_subtable(ROOT_NODE, _decoding_table_root_bits);
+    }
+
+    [[nodiscard]] const std::vector<HuffmanDecodingTableEntry>& decoding_table() const { return _decoding_table; }
+    [[nodiscard]] uint8_t decoding_table_root_bits() const { return _decoding_table_root_bits; }
+
+    /**
+     * Computes the code of every leaf symbol, which is required to encode symbols with a tree that was built
+     * node by node (e.g. when decoded from the ROM).
+     */
+    void build_encoding_table()
+    {
+        _codes = {};
+        this->build_encoding_table(ROOT_NODE, 0, 0);
+    }
+
+    [[nodiscard]] bool can_encode(uint8_t symbol) const
+    {
+        return symbol < _codes.size() && _codes[symbol].exists;
     }
 
-    [[nodiscard]] const std::vector<bool>& encode(uint8_t symbol) const
+    [[nodiscard]] const HuffmanCode& encode(uint8_t symbol) const
     {
-        return _encodingTable.at(symbol);
+        if(!this->can_encode(symbol))
+            throw LandstalkerException("Symbol " + std::to_string(symbol) + " cannot be encoded using this Huffman tree");
+        return _codes[symbol];
     }
 
     void bytes(std::vector<uint8_t>& value_bytes, std::vector<uint8_t>& structure_bytes)
     {
         BitstreamWriter structure_bitstream;
 
-        HuffmanTreeNode* currentNode = _root_node;
+        uint16_t current_node = ROOT_NODE;
         while (true)
         {
-            if (currentNode->is_leaf())
+            if (_nodes[current_node].is_leaf())
             {
                 structure_bitstream.add_bit(true);
-                value_bytes.emplace_back(currentNode->symbol());
+                value_bytes.emplace_back(_nodes[current_node].symbol());
 
                 // If we are our parent's right child, it means we completed this branch of the tree
                 // and we need to get back at a higher level
-                while (currentNode->parent() && currentNode->parent()->right_child() == currentNode)
-                    currentNode = currentNode->parent();
+                uint16_t parent = _nodes[current_node].parent();
+                while (parent != HuffmanTreeNode::NONE && _nodes[parent].right_child() == current_node)
+                {
+                    current_node = parent;
+                    parent = _nodes[current_node].parent();
+                }
 
                 // If we got back all the way to root node, it means we explored the full tree
-                if (currentNode == _root_node)
+                if (current_node == ROOT_NODE)
                     break;
 
-                currentNode = currentNode->parent()->right_child();
+                current_node = _nodes[parent].right_child();
             } 
             else
             {
                 structure_bitstream.add_bit(false);
-                currentNode = currentNode->left_child();
+                current_node = _nodes[current_node].left_child();
             }
         }
 
@@ -108,21 +256,109 @@ public:
     }
 
 private:
-    void build_encoding_table(HuffmanTreeNode* fromNode, const std::vector<bool>& bits = {})
+    uint16_t add_node(uint16_t parent)
+    {
+        if(_nodes.size() >= HuffmanTreeNode::NONE)
+            throw LandstalkerException("Too many nodes in Huffman tree");
+        _nodes.emplace_back(parent);
+        return static_cast<uint16_t>(_nodes.size() - 1);
+    }
+
+    /**
+     * Builds the nodes of a tree giving each symbol a code of the given length, by inserting canonical codes
+     * (assigned by increasing length) one by one starting from the root.
+     */
+    void build_nodes_from_code_lengths(const std::vector<SymbolCount>& symbol_counts, const std::vector<uint8_t>& code_lengths)
+    {
+        if(symbol_counts.size() < 2)
+        {
+            _nodes[ROOT_NODE].symbol(symbol_counts[0].symbol());
+            return;
+        }
+
+        std::vector<size_t> order(symbol_counts.size());
+        for(size_t i=0 ; i<order.size() ; ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return code_lengths[a] < code_lengths[b]; });
+
+        uint64_t code = 0;
+        uint8_t previous_length = code_lengths[order.front()];
+        for(size_t i : order)
+        {
+            code <<= (code_lengths[i] - previous_length);
+            previous_length = code_lengths[i];
+
+            uint16_t current_node = ROOT_NODE;
+            for(int bit = code_lengths[i] - 1 ; bit >= 0 ; --bit)
+            {
+                bool go_right = (code >> bit) & 0x1;
+                uint16_t child = go_right ? _nodes[current_node].right_child() : _nodes[current_node].left_child();
+                if(child == HuffmanTreeNode::NONE)
+                    child = go_right ? this->add_right_child(current_node) : this->add_left_child(current_node);
+                current_node = child;
+            }
+            _nodes[current_node].symbol(symbol_counts[i].symbol());
+
+            code += 1;
+        }
+    }
+
+    [[nodiscard]] uint8_t max_depth(uint16_t node) const
+    {
+        if(_nodes[node].is_leaf())
+            return 0;
+        return 1 + std::max(this->max_depth(_nodes[node].left_child()), this->max_depth(_nodes[node].right_child()));
+    }
+
+    uint16_t build_decoding_subtable(uint16_t node, uint8_t bits)
+    {
+        size_t offset = _decoding_table.size();
+        _decoding_table.resize(offset + (1 << bits));
+
+        for(uint32_t index = 0 ; index < (1u << bits) ; ++index)
+        {
+            uint16_t current_node = node;
+            uint8_t depth = 0;
+            while(!_nodes[current_node].is_leaf() && depth < bits)
+            {
+                bool bit = (index >> (bits - 1 - depth)) & 0x1;
+                current_node = bit ? _nodes[current_node].right_child() : _nodes[current_node].left_child();
+                ++depth;
+            }
+
+            HuffmanDecodingTableEntry entry;
+            if(_nodes[current_node].is_leaf())
+            {
+                entry.value = _nodes[current_node].symbol();
+                entry.length = depth;
+            }
+            else
+            {
+                entry.length = std::min(DECODING_SUBTABLE_BITS, this->max_depth(current_node));
+                entry.value = this->build_decoding_subtable(current_node, entry.length);
+                entry.is_link = true;
+            }
+            _decoding_table[offset + index] = entry;
+        }
+
+        return static_cast<uint16_t>(offset);
+    }
+
+    void build_encoding_table(uint16_t from_node, uint64_t code, uint8_t length)
     {
-        if (fromNode->is_leaf())
+        if (_nodes[from_node].is_leaf())
         {
-            _encodingTable[fromNode->symbol()] = bits;
+            if(_nodes[from_node].symbol() >= SYMBOL_COUNT)
+                throw LandstalkerException("Huffman tree contains an invalid symbol");
+            _codes[_nodes[from_node].symbol()] = { code, length, true };
         }
         else
         {
-            std::vector<bool> bits_plus_zero = bits;
-            bits_plus_zero.emplace_back(false);
-            this->build_encoding_table(fromNode->left_child(), bits_plus_zero);
+            if(length >= 64)
+                throw LandstalkerException("Huffman tree is too deep to be encoded");
 
-            std::vector<bool> bits_plus_one = bits;
-            bits_plus_one.emplace_back(true);
-            this->build_encoding_table(fromNode->right_child(), bits_plus_one);
+            this->build_encoding_table(_nodes[from_node].left_child(), code << 1, length + 1);
+            this->build_encoding_table(_nodes[from_node].right_child(), (code << 1) | 1, length + 1);
         }
     }
 };
@@ -2,39 +2,35 @@
 
 #include <cstdint>
 
+/**
+ * A node of a HuffmanTree. Nodes are stored contiguously inside their tree, and reference each other
+ * using their index in that storage.
+ */
 class HuffmanTreeNode
 {
+public:
+    static constexpr uint16_t NONE = 0xFFFF;
+
 private:
-    HuffmanTreeNode* _leftChild = nullptr;
-    HuffmanTreeNode* _rightChild = nullptr;
-    HuffmanTreeNode* _parent = nullptr;
+    uint16_t _left_child = NONE;
+    uint16_t _right_child = NONE;
+    uint16_t _parent = NONE;
     uint8_t _symbol = 0x00;
 
 public:
     HuffmanTreeNode() = default;
-    ~HuffmanTreeNode()
-    {
-        delete _leftChild;
-        delete _rightChild;
-    }
+    explicit HuffmanTreeNode(uint16_t parent) : _parent(parent)
+    {}
 
     void symbol(uint8_t symbol) { _symbol = symbol; }
     [[nodiscard]] const uint8_t& symbol() const { return _symbol; }
 
-    [[nodiscard]] HuffmanTreeNode* left_child() const { return _leftChild; }
-    void left_child(HuffmanTreeNode* node)
-    { 
-        _leftChild = node;
-        node->_parent = this; 
-    }
-
-    [[nodiscard]] HuffmanTreeNode* right_child() const { return _rightChild; }
-    void right_child(HuffmanTreeNode* node)
-    {
-        _rightChild = node; 
-        node->_parent = this; 
-    }
-
-    [[nodiscard]] HuffmanTreeNode* parent() const { return _parent; }
-    [[nodiscard]] bool is_leaf() const { return !_leftChild && !_rightChild; }
-};
\ No newline at end of file
+    [[nodiscard]] uint16_t left_child() const { return _left_child; }
+    void left_child(uint16_t node) { _left_child = node; }
+
+    [[nodiscard]] uint16_t right_child() const { return _right_child; }
+    void right_child(uint16_t node) { _right_child = node; }
+
+    [[nodiscard]] uint16_t parent() const { return _parent; }
+    [[nodiscard]] bool is_leaf() const { return _left_child == NONE && _right_child == NONE; }
+};
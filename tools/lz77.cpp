@@ -1,15 +1,26 @@
 #include "lz77.hpp"
+#include "../exceptions.hpp"
 
-std::vector<uint8_t> decode_lz77(const uint8_t*& it)
+#include <cstring>
+#include <algorithm>
+
+size_t decode_lz77(const uint8_t*& it, const uint8_t* input_end, uint8_t* output, size_t output_size)
 {
-    std::vector<uint8_t> decompressed_bytes;
-    uint8_t cmd;
+    auto require_input = [&](size_t byte_count)
+    {
+        if(input_end && it + byte_count > input_end)
+            throw LandstalkerException("LZ77 stream goes past the end of input data");
+    };
+
+    size_t written_bytes = 0;
+    uint8_t cmd = 0;
     uint8_t cmd_remaining_bits = 0;
 
     while(true)
     {
         if(!cmd_remaining_bits)
         {
+            require_input(1);
             cmd = *it;
             cmd_remaining_bits = 8;
             it += 1;
@@ -21,31 +32,157 @@ std::vector<uint8_t> decode_lz77(const uint8_t*& it)
 
         if(next_cmd_bit)
         {
-            decompressed_bytes.emplace_back(*it);
+            // Literal byte
+            require_input(1);
+            if(written_bytes == output_size)
+                throw LandstalkerException("LZ77 stream decompresses to more bytes than the output can hold");
+            output[written_bytes++] = *it;
             it += 1;
+            continue;
         }
-        else
+
+        require_input(2);
+        uint8_t byte_1 = *it;
+        uint8_t byte_2 = *(it + 1);
+        it += 2;
+
+        uint16_t offset = (byte_1 & 0xF0) << 4 | byte_2;
+        if(!offset)
+            break;
+
+        size_t length = 18 - (byte_1 & 0x0F);
+        if(offset > written_bytes)
+            throw LandstalkerException("LZ77 back-reference points before the beginning of decompressed data");
+        if(length > output_size - written_bytes)
+            throw LandstalkerException("LZ77 stream decompresses to more bytes than the output can hold");
+
+        // Copy the back-reference by chunks of at most `offset` bytes, which makes each chunk a non-overlapping copy
+        // even when the reference overlaps with the bytes it is producing (e.g. repeating the last byte)
+        uint8_t* destination = output + written_bytes;
+        while(length > 0)
         {
-            uint8_t byte_1 = *it;
-            it += 1;
-            uint8_t byte_2 = *it;
-            it += 1;
+            size_t chunk_size = std::min<size_t>(length, offset);
+            std::memcpy(destination, destination - offset, chunk_size);
+            destination += chunk_size;
+            length -= chunk_size;
+        }
+        written_bytes = destination - output;
+    }
 
-            uint16_t offset = (byte_1 & 0xF0) << 4 | byte_2;
-            uint8_t length = 18 - (byte_1 & 0x0F);
-            if(offset)
+    return written_bytes;
+}
+
+std::vector<LZ77Token> parse_lz77(const uint8_t* data, size_t size)
+{
+    constexpr size_t HASH_SIZE = 0x1000;
+    constexpr size_t MAX_CHAIN_LENGTH = 256;
+    constexpr uint32_t NO_POSITION = UINT32_MAX;
+
+    auto hash_at = [data](size_t pos) -> size_t {
+        return ((data[pos] << 4) ^ (data[pos+1] << 2) ^ data[pos+2]) & (HASH_SIZE - 1);
+    };
+
+    // Hash chains linking every position to the previous position sharing the same 3-byte hash
+    std::vector<uint32_t> head(HASH_SIZE, NO_POSITION);
+    std::vector<uint32_t> previous(size, NO_POSITION);
+    size_t hashed_until = 0;
+    auto hash_up_to = [&](size_t pos) {
+        for( ; hashed_until < pos && hashed_until + LZ77_MIN_MATCH_LENGTH <= size ; ++hashed_until)
+        {
+            size_t hash = hash_at(hashed_until);
+            previous[hashed_until] = head[hash];
+            head[hash] = (uint32_t)hashed_until;
+        }
+    };
+
+    std::vector<LZ77Token> tokens;
+    tokens.reserve(size);
+
+    size_t pos = 0;
+    while(pos < size)
+    {
+        hash_up_to(pos);
+
+        LZ77Token token;
+        size_t max_length = std::min<size_t>(LZ77_MAX_MATCH_LENGTH, size - pos);
+        if(max_length >= LZ77_MIN_MATCH_LENGTH)
+        {
+            size_t best_length = 0;
+            uint32_t candidate = head[hash_at(pos)];
+            for(size_t i=0 ; i<MAX_CHAIN_LENGTH && candidate != NO_POSITION ; ++i, candidate = previous[candidate])
             {
-                while(length != 0)
+                size_t offset = pos - candidate;
+                if(offset > LZ77_MAX_OFFSET)
+                    break;
+
+                size_t length = 0;
+                while(length < max_length && data[candidate + length] == data[pos + length])
+                    ++length;
+
+                if(length > best_length)
                 {
-                    uint8_t byte_to_copy = decompressed_bytes[decompressed_bytes.size() - offset];
-                    decompressed_bytes.emplace_back(byte_to_copy);
-                    length -= 1;
+                    best_length = length;
+                    token.offset = (uint16_t)offset;
+                    if(length == max_length)
+                        break;
                 }
             }
-            else break;
+
+            if(best_length >= LZ77_MIN_MATCH_LENGTH)
+                token.length = (uint8_t)best_length;
+            else
+                token.offset = 0;
         }
+
+        tokens.emplace_back(token);
+        pos += token.length;
     }
 
-    return decompressed_bytes;
+    return tokens;
 }
 
+std::vector<uint8_t> encode_lz77(const uint8_t* data, size_t size)
+{
+    std::vector<LZ77Token> tokens = parse_lz77(data, size);
+
+    std::vector<uint8_t> encoded_bytes;
+    encoded_bytes.reserve(size + (size / 8) + 3);
+
+    size_t cmd_byte_index = 0;
+    uint8_t cmd_remaining_bits = 0;
+    auto add_cmd_bit = [&](bool bit) {
+        if(!cmd_remaining_bits)
+        {
+            cmd_byte_index = encoded_bytes.size();
+            encoded_bytes.emplace_back(0x00);
+            cmd_remaining_bits = 8;
+        }
+        cmd_remaining_bits -= 1;
+        if(bit)
+            encoded_bytes[cmd_byte_index] |= (1 << cmd_remaining_bits);
+    };
+
+    const uint8_t* it = data;
+    for(const LZ77Token& token : tokens)
+    {
+        if(token.is_literal())
+        {
+            add_cmd_bit(true);
+            encoded_bytes.emplace_back(*it);
+        }
+        else
+        {
+            add_cmd_bit(false);
+            encoded_bytes.emplace_back(((token.offset >> 4) & 0xF0) | (LZ77_MAX_MATCH_LENGTH - token.length));
+            encoded_bytes.emplace_back(token.offset & 0xFF);
+        }
+        it += token.length;
+    }
+
+    // End marker is a back-reference with a null offset
+    add_cmd_bit(false);
+    encoded_bytes.emplace_back(0x00);
+    encoded_bytes.emplace_back(0x00);
+
+    return encoded_bytes;
+}
@@ -2,5 +2,41 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
-std::vector<uint8_t> decode_lz77(const uint8_t*& it);
+/**
+ * A token of a LZ77 parse: either a literal byte (offset is 0, length is 1) or a back-reference copying `length`
+ * bytes located `offset` bytes before the current position.
+ */
+struct LZ77Token {
+    uint16_t offset = 0;
+    uint8_t length = 1;
+
+    [[nodiscard]] bool is_literal() const { return offset == 0; }
+};
+
+constexpr uint16_t LZ77_MAX_OFFSET = 0xFFF;
+constexpr uint8_t LZ77_MIN_MATCH_LENGTH = 3;
+constexpr uint8_t LZ77_MAX_MATCH_LENGTH = 18;
+
+/**
+ * Decodes a LZ77 compressed stream into a caller-provided buffer.
+ *
+ * @param it an iterator on the compressed data, which is advanced past the end marker of the stream
+ * @param input_end the end of readable input data, or nullptr if the input is trusted to be well-formed
+ * @param output the buffer where decompressed bytes are written
+ * @param output_size the amount of bytes that can be written inside the output buffer
+ * @return the amount of decompressed bytes written inside the output buffer
+ */
+size_t decode_lz77(const uint8_t*& it, const uint8_t* input_end, uint8_t* output, size_t output_size);
+
+/**
+ * Greedily parses `data` into LZ77 tokens, always taking the longest back-reference available at each position.
+ * Back-references never point before `data`, which means the parse can be decoded on its own.
+ */
+std::vector<LZ77Token> parse_lz77(const uint8_t* data, size_t size);
+
+/**
+ * Encodes `data` as a LZ77 compressed stream (including its end marker) that can be read by `decode_lz77`.
+ */
+std::vector<uint8_t> encode_lz77(const uint8_t* data, size_t size);
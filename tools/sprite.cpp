@@ -3,25 +3,104 @@
 #include "../exceptions.hpp"
 #include "lodepng.h"
 #include "lz77.hpp"
-#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+// SSSE3 is not part of baseline x86-64, so the SIMD path is compiled for it separately and picked at runtime unless
+// the whole build already targets it (e.g. with -mssse3 or -march=native)
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define REMAP_NIBBLES_SSSE3
+#include <tmmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 constexpr uint8_t TILE_SIZE_IN_BYTES = 32;
 
-void Sprite::replace_color(uint8_t color_index, uint8_t new_color_index, size_t start_index, size_t end_index)
+#if defined(REMAP_NIBBLES_SSSE3)
+/**
+ * Remaps both nibbles of bytes from `begin` through `mapping` 16 bytes at a time, using a byte shuffle as a 16-entry
+ * lookup table.
+ * @return a pointer to the first byte which was not remapped (less than 16 bytes before `end`)
+ */
+__attribute__((target("ssse3")))
+static uint8_t* remap_nibbles_ssse3(uint8_t* it, uint8_t* end, const std::array<uint8_t, 16>& mapping)
 {
-    for(size_t i=start_index ; i<end_index && i<_data.size() ; ++i)
+    const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mapping.data()));
+    const __m128i low_nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i high_nibble_mask = _mm_set1_epi8(static_cast<char>(0xF0));
+    for( ; end - it >= 16 ; it += 16)
     {
-        uint8_t& byte = _data.at(i);
-        uint8_t msc = byte >> 4;
-        uint8_t lsc = byte & 0x0F;
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+        __m128i low = _mm_shuffle_epi8(lut, _mm_and_si128(bytes, low_nibble_mask));
+        __m128i high = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble_mask));
+        high = _mm_and_si128(_mm_slli_epi16(high, 4), high_nibble_mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(it), _mm_or_si128(high, _mm_and_si128(low, low_nibble_mask)));
+    }
+    return it;
+}
 
-        if(msc == color_index)
-            msc = new_color_index;
-        if(lsc == color_index)
-            lsc = new_color_index;
+static bool cpu_supports_ssse3()
+{
+#if defined(__SSSE3__)
+    return true;
+#else
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+#endif
+}
+#endif
 
-        byte = (msc << 4) | lsc;
+/**
+ * Remaps both nibbles of every byte in [begin, end) through `mapping`, processing 16 bytes at a time using
+ * a byte shuffle as a 16-entry lookup table when the CPU supports it.
+ */
+static void remap_nibbles(uint8_t* begin, uint8_t* end, const std::array<uint8_t, 16>& mapping)
+{
+    uint8_t* it = begin;
+
+#if defined(REMAP_NIBBLES_SSSE3)
+    if(cpu_supports_ssse3())
+        it = remap_nibbles_ssse3(it, end, mapping);
+#elif defined(__aarch64__)
+    const uint8x16_t lut = vandq_u8(vld1q_u8(mapping.data()), vdupq_n_u8(0x0F));
+    const uint8x16_t low_nibble_mask = vdupq_n_u8(0x0F);
+    for( ; end - it >= 16 ; it += 16)
+    {
+        uint8x16_t bytes = vld1q_u8(it);
+        uint8x16_t low = vqtbl1q_u8(lut, vandq_u8(bytes, low_nibble_mask));
+        uint8x16_t high = vqtbl1q_u8(lut, vshrq_n_u8(bytes, 4));
+        vst1q_u8(it, vorrq_u8(vshlq_n_u8(high, 4), low));
     }
+#endif
+
+    if(it == end)
+        return;
+
+    std::array<uint8_t, 256> byte_mapping {};
+    for(size_t i=0 ; i<256 ; ++i)
+        byte_mapping[i] = ((mapping[i >> 4] & 0x0F) << 4) | (mapping[i & 0x0F] & 0x0F);
+    for( ; it != end ; ++it)
+        *it = byte_mapping[*it];
+}
+
+void Sprite::remap_colors(const std::array<uint8_t, 16>& mapping, size_t start_index, size_t end_index)
+{
+    end_index = std::min(end_index, _data.size());
+    if(start_index >= end_index)
+        return;
+    remap_nibbles(_data.data() + start_index, _data.data() + end_index, mapping);
+}
+
+void Sprite::replace_color(uint8_t color_index, uint8_t new_color_index, size_t start_index, size_t end_index)
+{
+    std::array<uint8_t, 16> mapping {};
+    for(uint8_t i=0 ; i<16 ; ++i)
+        mapping[i] = i;
+    if(color_index < mapping.size())
+        mapping[color_index] = new_color_index;
+
+    this->remap_colors(mapping, start_index, end_index);
 }
 
 void Sprite::replace_color_in_tile(uint8_t color_index, uint8_t new_color_index, uint8_t tile_index)
@@ -78,98 +157,215 @@ static uint16_t read_word_from(const uint8_t* it)
     return (msb << 8) | lsb;
 }
 
-ByteArray Sprite::encode()
+static constexpr uint16_t SPRITE_COMMAND_MAX_COUNT = 0x0FFF;
+static constexpr uint16_t SPRITE_COMMAND_RAW = 0x0000;
+static constexpr uint16_t SPRITE_COMMAND_LZ77 = 0x2000;
+static constexpr uint16_t SPRITE_COMMAND_LAST = 0x4000;
+static constexpr uint16_t SPRITE_COMMAND_ZEROES = 0x8000;
+
+enum class SpriteSegmentType : uint8_t { RAW, ZEROES, LZ77 };
+
+static size_t chunked_command_count(size_t word_count)
 {
-    constexpr size_t THRESHOLD_FOR_GROUPING_ZEROES = 8;
+    return (word_count + SPRITE_COMMAND_MAX_COUNT - 1) / SPRITE_COMMAND_MAX_COUNT;
+}
 
-    if(_data.size() > 0xFFF)
-        throw LandstalkerException("Trying to encode a sprite without compression that is above 0xFFF bytes in size");
+/**
+ * Computes the size of the LZ77 streams that would encode `data[0..prefix_length]` for every prefix length
+ * of `prefix_lengths` (which must be sorted), using a single parse of the full data.
+ * A greedy parse of a prefix is the same as the greedy parse of the full data, except for the token crossing the end
+ * of the prefix which gets truncated.
+ */
+static std::vector<size_t> lz77_prefix_sizes(const uint8_t* data, size_t size, const std::vector<size_t>& prefix_lengths)
+{
+    std::vector<LZ77Token> tokens = parse_lz77(data, size);
 
+    std::vector<size_t> sizes;
+    sizes.reserve(prefix_lengths.size());
+
+    size_t token_index = 0;
+    size_t position = 0;
+    size_t flag_count = 0;
+    size_t payload_size = 0;
+    for(size_t prefix_length : prefix_lengths)
+    {
+        while(token_index < tokens.size() && position + tokens[token_index].length <= prefix_length)
+        {
+            const LZ77Token& token = tokens[token_index++];
+            flag_count += 1;
+            payload_size += token.is_literal() ? 1 : 2;
+            position += token.length;
+        }
+
+        // Handle the truncated token, then add the end marker
+        size_t remainder = prefix_length - position;
+        size_t prefix_flag_count = flag_count + 1;
+        size_t prefix_payload_size = payload_size + 2;
+        if(remainder >= LZ77_MIN_MATCH_LENGTH)
+        {
+            prefix_flag_count += 1;
+            prefix_payload_size += 2;
+        }
+        else
+        {
+            prefix_flag_count += remainder;
+            prefix_payload_size += remainder;
+        }
+
+        sizes.emplace_back(((prefix_flag_count + 7) / 8) + prefix_payload_size);
+    }
+
+    return sizes;
+}
+
+ByteArray Sprite::encode()
+{
     ByteArray encoded_bytes;
     for(const SubSpriteMetadata& subsprite : _subsprites)
         encoded_bytes.add_word(subsprite.to_word());
 
-    ByteArray current_sequence;
-    uint16_t zeroes_buffer = 0;
-    for(size_t index_in_data = 0; index_in_data < _data.size() ; index_in_data += 0x2)
+    const size_t word_count = _data.size() / 2;
+    if(word_count == 0)
     {
-        uint16_t current_word = read_word_from(&_data[index_in_data]);
+        encoded_bytes.add_word(SPRITE_COMMAND_ZEROES | SPRITE_COMMAND_LAST);
+        return encoded_bytes;
+    }
 
-        if(current_word == 0x0000)
+    // Segment boundaries (in words) are placed around every zero sequence that could be worth encoding separately,
+    // and at both ends of the data
+    std::vector<size_t> boundaries = { 0 };
+    std::vector<bool> zero_segment_after_boundary;
+    for(size_t i=0 ; i<word_count ; )
+    {
+        if(read_word_from(&_data[i*2]) != 0x0000)
         {
-            zeroes_buffer += 1;
+            ++i;
             continue;
         }
 
-        if(zeroes_buffer > 0)
-        {
-            if(zeroes_buffer >= THRESHOLD_FOR_GROUPING_ZEROES)
-            {
-                // This zeroes sequence is big enough to be encoded separately, do it
-                if(!current_sequence.empty())
-                {
-                    // If there was a pending sequence before encountering those zeroes, commit it now
-                    encoded_bytes.add_word(0x0000 | (current_sequence.size() / 2));
-                    encoded_bytes.add_bytes(current_sequence);
-                    current_sequence.clear();
-                }
+        size_t zero_sequence_end = i;
+        while(zero_sequence_end < word_count && read_word_from(&_data[zero_sequence_end*2]) == 0x0000)
+            ++zero_sequence_end;
 
-                // End and commit the current zero collection sequence
-                encoded_bytes.add_word(0x8000 | zeroes_buffer);
-            }
-            else
+        if(zero_sequence_end - i >= 2)
+        {
+            if(boundaries.back() != i)
             {
-                // This zeroes sequence is not big enough to be encoded separately, include it inside the current sequence
-                for(uint16_t i=0 ; i<zeroes_buffer ; ++i)
-                    current_sequence.add_word(0x0000);
+                zero_segment_after_boundary.emplace_back(false);
+                boundaries.emplace_back(i);
             }
-
-            zeroes_buffer = 0;
+            zero_segment_after_boundary.emplace_back(true);
+            boundaries.emplace_back(zero_sequence_end);
         }
-
-        current_sequence.add_word(current_word);
+        i = zero_sequence_end;
+    }
+    if(boundaries.back() != word_count)
+    {
+        zero_segment_after_boundary.emplace_back(false);
+        boundaries.emplace_back(word_count);
     }
 
-
-    if(zeroes_buffer >= THRESHOLD_FOR_GROUPING_ZEROES)
+    // Find the cheapest way to encode data up to each boundary using dynamic programming, where each step encodes
+    // the data between two boundaries using the cheapest of the three available commands.
+    struct Step {
+        size_t cost = SIZE_MAX;
+        size_t previous_boundary = 0;
+        SpriteSegmentType type = SpriteSegmentType::RAW;
+    };
+    std::vector<Step> steps(boundaries.size());
+    steps[0].cost = 0;
+
+    for(size_t from = 0 ; from < boundaries.size() - 1 ; ++from)
     {
-        // This zeroes sequence is big enough to be encoded separately, do it
-        if(!current_sequence.empty())
+        std::vector<size_t> prefix_lengths;
+        for(size_t to = from + 1 ; to < boundaries.size() ; ++to)
+            prefix_lengths.emplace_back((boundaries[to] - boundaries[from]) * 2);
+        const uint8_t* segment_start = &_data[boundaries[from] * 2];
+        std::vector<size_t> lz77_sizes = lz77_prefix_sizes(segment_start, prefix_lengths.back(), prefix_lengths);
+
+        for(size_t to = from + 1 ; to < boundaries.size() ; ++to)
         {
-            // If there was a pending sequence before encountering those zeroes, commit it now
-            encoded_bytes.add_word(0x0000 | (current_sequence.size() / 2));
-            encoded_bytes.add_bytes(current_sequence);
+            size_t segment_word_count = boundaries[to] - boundaries[from];
+            auto try_candidate = [&](size_t segment_cost, SpriteSegmentType type) {
+                size_t cost = steps[from].cost + segment_cost;
+                if(cost < steps[to].cost)
+                    steps[to] = { cost, from, type };
+            };
+
+            if(to == from + 1 && zero_segment_after_boundary[from])
+                try_candidate(chunked_command_count(segment_word_count) * 2, SpriteSegmentType::ZEROES);
+
+            try_candidate(chunked_command_count(segment_word_count) * 2 + segment_word_count * 2, SpriteSegmentType::RAW);
+
+            // Commands are read as words, so a LZ77 stream followed by another command must have an even size
+            // to keep the next command aligned
+            size_t lz77_size = lz77_sizes[to - from - 1];
+            if(lz77_size % 2 == 0 || to == boundaries.size() - 1)
+                try_candidate(2 + lz77_size, SpriteSegmentType::LZ77);
         }
-
-        // End and commit the current zero collection sequence
-        encoded_bytes.add_word(0x8000 | 0x4000 | zeroes_buffer);
     }
-    else
+
+    // Backtrack from the last boundary to find the chosen segments, then encode them in order
+    std::vector<size_t> segment_ends;
+    for(size_t boundary = boundaries.size() - 1 ; boundary > 0 ; boundary = steps[boundary].previous_boundary)
+        segment_ends.emplace_back(boundary);
+    std::reverse(segment_ends.begin(), segment_ends.end());
+
+    encoded_bytes.reserve(encoded_bytes.size() + steps.back().cost);
+    for(size_t segment_end : segment_ends)
     {
-        // This zeroes sequence is not big enough to be encoded separately, include it inside the current sequence
-        // and commit it
-        for(uint16_t i=0 ; i<zeroes_buffer ; ++i)
-            current_sequence.add_word(0x0000);
+        const Step& step = steps[segment_end];
+        size_t first_word = boundaries[step.previous_boundary];
+        size_t last_word = boundaries[segment_end];
+        bool is_last_segment = (segment_end == boundaries.size() - 1);
+
+        if(step.type == SpriteSegmentType::LZ77)
+        {
+            encoded_bytes.add_word(SPRITE_COMMAND_LZ77 | (is_last_segment ? SPRITE_COMMAND_LAST : 0));
+            encoded_bytes.add_bytes(encode_lz77(&_data[first_word * 2], (last_word - first_word) * 2));
+            continue;
+        }
 
-        if(!current_sequence.empty())
+        uint16_t command_type = (step.type == SpriteSegmentType::ZEROES) ? SPRITE_COMMAND_ZEROES : SPRITE_COMMAND_RAW;
+        while(first_word < last_word)
         {
-            encoded_bytes.add_word(0x4000 | (current_sequence.size() / 2));
-            encoded_bytes.add_bytes(current_sequence);
+            size_t chunk_word_count = std::min<size_t>(last_word - first_word, SPRITE_COMMAND_MAX_COUNT);
+            bool is_last_chunk = is_last_segment && (first_word + chunk_word_count == last_word);
+            encoded_bytes.add_word(command_type | (is_last_chunk ? SPRITE_COMMAND_LAST : 0) | chunk_word_count);
+            if(step.type == SpriteSegmentType::RAW)
+                encoded_bytes.insert(encoded_bytes.end(), _data.begin() + (long)(first_word * 2), _data.begin() + (long)((first_word + chunk_word_count) * 2));
+            first_word += chunk_word_count;
         }
     }
 
     return encoded_bytes;
 }
 
-Sprite Sprite::decode_from(const uint8_t* it)
+/**
+ * Decodes the sprite located at `it` inside this Sprite object, reusing its already allocated buffers.
+ * This makes decoding many sprites in a row using the same Sprite object allocation-free.
+ *
+ * @param it an iterator on the encoded sprite data
+ * @param end the end of readable input data, or nullptr if the input is trusted to be well-formed
+ * @return the size of the encoded sprite in bytes
+ */
+size_t Sprite::decode(const uint8_t* it, const uint8_t* end)
 {
+    const uint8_t* begin = it;
+    auto require_input = [&](size_t byte_count)
+    {
+        if(end && it + byte_count > end)
+            throw LandstalkerException("Sprite data goes past the end of input data");
+    };
+
     size_t bytes_prediction = 0;
-    std::vector<SubSpriteMetadata> subsprites;
+    _subsprites.clear();
     while(true)
     {
+        require_input(2);
         SubSpriteMetadata subsprite(read_word_from(it));
         it += 2;
-        subsprites.emplace_back(subsprite);
+        _subsprites.emplace_back(subsprite);
 
         bytes_prediction += (subsprite.tile_count_w * subsprite.tile_count_h * TILE_SIZE_IN_BYTES);
 
@@ -177,116 +373,156 @@ Sprite Sprite::decode_from(const uint8_t* it)
             break;
     }
 
-    std::vector<uint8_t> result_bytes;
-    result_bytes.reserve(bytes_prediction);
+    // Subsprites metadata tells us exactly how many bytes the sprite is made of, so we can decode everything
+    // straight into the final buffer
+    _data.resize(bytes_prediction);
+    uint8_t* output = _data.data();
+    size_t written_bytes = 0;
+
     uint8_t ctrl = 0;
     while((ctrl & 0x04) == 0)
     {
+        require_input(2);
         uint16_t command = read_word_from(it);
         it += 2;
 
         ctrl = command >> 12;
-        uint16_t count = command & 0x0FFF;
+        size_t count = command & 0x0FFF;
 
         if (ctrl & 0x08)
         {
             // Insert X zero words
-            for(size_t i=0 ; i<count*2 ; ++i)
-                result_bytes.emplace_back(0x00);
+            size_t byte_count = count * 2;
+            if(byte_count > bytes_prediction - written_bytes)
+                throw LandstalkerException("Sprite data decodes to more bytes than its subsprites can hold");
+            std::memset(output + written_bytes, 0x00, byte_count);
+            written_bytes += byte_count;
         }
         else if (ctrl & 0x02)
         {
-            // Read X compressed bytes
-            std::vector<uint8_t> decompressed = decode_lz77(it);
-            result_bytes.insert(result_bytes.end(), decompressed.begin(), decompressed.end());
+            // Read LZ77 compressed bytes
+            written_bytes += decode_lz77(it, end, output + written_bytes, bytes_prediction - written_bytes);
         }
         else
         {
             // Copy X raw words
-            for(size_t i=0 ; i<count*2 ; ++i)
-            {
-                result_bytes.emplace_back(read_byte_from(it));
-                it += 1;
-            }
+            size_t byte_count = count * 2;
+            if(byte_count > bytes_prediction - written_bytes)
+                throw LandstalkerException("Sprite data decodes to more bytes than its subsprites can hold");
+            require_input(byte_count);
+            std::memcpy(output + written_bytes, it, byte_count);
+            it += byte_count;
+            written_bytes += byte_count;
         }
     }
 
-    return { result_bytes, subsprites };
+    _data.resize(written_bytes);
+    return it - begin;
+}
+
+Sprite Sprite::decode_from(const uint8_t* it, const uint8_t* end)
+{
+    Sprite sprite;
+    sprite.decode(it, end);
+    return sprite;
 }
 
-void Sprite::write_to_png(const std::string& path, const ColorPalette<16>& palette)
+/**
+ * Unpacks a row of 8 pixels (4 bytes, two 4bpp pixels per byte, leftmost pixel in the high nibble) into 8 bytes.
+ */
+static void unpack_tile_row(const uint8_t* row, uint8_t* output)
 {
+    uint64_t packed = (uint32_t(row[0]) << 24) | (uint32_t(row[1]) << 16) | (uint32_t(row[2]) << 8) | uint32_t(row[3]);
+
+    // Spread the eight nibbles so that each one ends up in the low half of its own byte, leftmost pixel first
+    packed = ((packed & 0x00000000FFFF0000ULL) << 16) | (packed & 0x000000000000FFFFULL);
+    packed = ((packed & 0x0000FF000000FF00ULL) << 8) | (packed & 0x000000FF000000FFULL);
+    packed = ((packed & 0x00F000F000F000F0ULL) << 4) | (packed & 0x000F000F000F000FULL);
+
+    for(size_t i=0 ; i<8 ; ++i)
+        output[i] = static_cast<uint8_t>(packed >> (56 - (i * 8)));
+}
+
+SpriteImage Sprite::rasterize() const
+{
+    SpriteImage image;
+    if(_subsprites.empty())
+        return image;
+
     int origin_x = INT32_MAX;
     int origin_y = INT32_MAX;
-    int highest_x = 0;
-    int highest_y = 0;
+    int highest_x = INT32_MIN;
+    int highest_y = INT32_MIN;
     for(auto& subsprite : _subsprites)
     {
-        if(subsprite.x < origin_x)
-            origin_x = (int)subsprite.x;
-        if(subsprite.y < origin_y)
-            origin_y = (int)subsprite.y;
-
-        if(subsprite.x + (subsprite.tile_count_w * 8) > highest_x)
-            highest_x = subsprite.x + (subsprite.tile_count_w * 8);
-        if(subsprite.y + (subsprite.tile_count_h * 8) > highest_y)
-            highest_y = subsprite.y + (subsprite.tile_count_h * 8);
+        origin_x = std::min<int>(origin_x, subsprite.x);
+        origin_y = std::min<int>(origin_y, subsprite.y);
+        highest_x = std::max<int>(highest_x, subsprite.x + (subsprite.tile_count_w * 8));
+        highest_y = std::max<int>(highest_y, subsprite.y + (subsprite.tile_count_h * 8));
     }
 
-    unsigned int width = highest_x - origin_x;
-    unsigned int height = highest_y - origin_y;
-
-    // The image has width * height RGBA pixels (each one composed of 4 bytes : R G B A)
-    std::vector<uint8_t> image_data;
-    image_data.resize(width * height * 4, 0);
+    image.origin_x = origin_x;
+    image.origin_y = origin_y;
+    image.width = highest_x - origin_x;
+    image.height = highest_y - origin_y;
+    image.pixels.resize(image.width * image.height, 0);
 
+    // Tiles are blitted one row of 8 pixels at a time, stopping early if data is missing for the last tiles
     size_t current_tile_index = 0;
     for(auto& subsprite : _subsprites)
     {
-        unsigned int global_subsprite_origin_x = subsprite.x - origin_x;
-        unsigned int global_subsprite_origin_y = subsprite.y - origin_y;
+        size_t subsprite_origin_x = subsprite.x - origin_x;
+        size_t subsprite_origin_y = subsprite.y - origin_y;
 
-        for(size_t tile_y = 0 ; tile_y < subsprite.tile_count_h ; ++tile_y)
+        for(size_t tile_x = 0 ; tile_x < subsprite.tile_count_w ; ++tile_x)
         {
-            for(size_t tile_x = 0 ; tile_x < subsprite.tile_count_w ; ++tile_x)
+            for(size_t tile_y = 0 ; tile_y < subsprite.tile_count_h ; ++tile_y)
             {
                 size_t tile_index = (tile_x * subsprite.tile_count_h) + tile_y + current_tile_index;
-                for(size_t x=0 ; x<8 ; ++x)
+                size_t tile_offset = tile_index * TILE_SIZE_IN_BYTES;
+                uint8_t* output = &image.pixels[((subsprite_origin_y + (tile_y * 8)) * image.width)
+                                                + subsprite_origin_x + (tile_x * 8)];
+
+                for(size_t y = 0 ; y < 8 && tile_offset + 4 <= _data.size() ; ++y)
                 {
-                    for(size_t y = 0 ; y < 8 ; ++y)
-                    {
-                        uint8_t color_index = this->get_pixel(tile_index, x, y);
-                        Color color = palette[color_index];
-
-                        size_t global_x = global_subsprite_origin_x + (tile_x * 8) + x;
-                        size_t global_y = global_subsprite_origin_y + (tile_y * 8) + y;
-                        size_t pixel_index = (global_y * width + global_x) * 4;
-
-                        image_data[pixel_index] = color.r();
-                        image_data[pixel_index+1] = color.g();
-                        image_data[pixel_index+2] = color.b();
-                        image_data[pixel_index+3] = color_index ? 0xFF : 0x00;
-                    }
+                    unpack_tile_row(&_data[tile_offset], output);
+                    tile_offset += 4;
+                    output += image.width;
                 }
             }
         }
         current_tile_index += subsprite.tile_count_h * subsprite.tile_count_w;
     }
 
+    return image;
+}
+
+void SpriteImage::write_to_png(const std::string& path, const ColorPalette<16>& palette) const
+{
+    // Pixels already are palette indices, so they can be handed to lodepng as-is without any color conversion
     lodepng::State state;
-    lodepng_state_init(&state);
     state.encoder.auto_convert = false;
+    state.info_raw.colortype = LCT_PALETTE;
+    state.info_raw.bitdepth = 8;
     state.info_png.color.colortype = LCT_PALETTE;
+    state.info_png.color.bitdepth = 8;
     size_t i=0;
     for(Color c : palette)
-        lodepng_palette_add(&state.info_png.color, c.r(), c.g(), c.b(), (i++) ? 0xFF : 0x00);
+    {
+        uint8_t alpha = (i++) ? 0xFF : 0x00;
+        lodepng_palette_add(&state.info_raw, c.r(), c.g(), c.b(), alpha);
+        lodepng_palette_add(&state.info_png.color, c.r(), c.g(), c.b(), alpha);
+    }
 
     std::vector<uint8_t> encoded_bytes;
-    unsigned int error = lodepng::encode(encoded_bytes, image_data, width, height, state);
+    unsigned int error = lodepng::encode(encoded_bytes, pixels, width, height, state);
+    if(!error)
+        error = lodepng::save_file(encoded_bytes, path);
     if(error)
-        std::cout << "PNG encoding error " << error << ": "<< lodepng_error_text(error) << std::endl;
+        throw LandstalkerException("Could not write PNG file '" + path + "': " + lodepng_error_text(error));
+}
 
-    error = lodepng::save_file(encoded_bytes, path);
-    if(error)
-        std::cout << "PNG saving error " << error << ": "<< lodepng_error_text(error) << std::endl;
+void Sprite::write_to_png(const std::string& path, const ColorPalette<16>& palette) const
+{
+    this->rasterize().write_to_png(path, palette);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include "byte_array.hpp"
@@ -35,6 +36,19 @@ struct SubSpriteMetadata {
     [[nodiscard]] uint16_t to_word() const { return original_word; }
 };
 
+/**
+ * A sprite rendered as an 8-bit indexed image, where each byte is a palette index
+ */
+struct SpriteImage {
+    int origin_x = 0;
+    int origin_y = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    std::vector<uint8_t> pixels;
+
+    void write_to_png(const std::string& path, const ColorPalette<16>& palette) const;
+};
+
 class Sprite
 {
 private:
@@ -54,6 +68,8 @@ public:
             _subsprites (std::move(subsprites))
     {}
 
+    void remap_colors(const std::array<uint8_t, 16>& mapping) { this->remap_colors(mapping, 0, _data.size()); }
+    void remap_colors(const std::array<uint8_t, 16>& mapping, size_t start_index, size_t end_index);
     void replace_color(uint8_t color_index, uint8_t new_color_index) { this->replace_color(color_index, new_color_index, 0, _data.size()); }
     void replace_color(uint8_t color_index, uint8_t new_color_index, size_t start_index, size_t end_index);
     void replace_color_in_tile(uint8_t color_index, uint8_t new_color_index, uint8_t tile_index);
@@ -65,8 +81,10 @@ public:
     [[nodiscard]] const std::vector<SubSpriteMetadata>& subsprites() const { return _subsprites; }
 
     ByteArray encode();
-    static Sprite decode_from(const uint8_t* it);
+    size_t decode(const uint8_t* it, const uint8_t* end = nullptr);
+    static Sprite decode_from(const uint8_t* it, const uint8_t* end = nullptr);
 
-    void write_to_png(const std::string& path, const ColorPalette<16>& palette);
+    [[nodiscard]] SpriteImage rasterize() const;
+    void write_to_png(const std::string& path, const ColorPalette<16>& palette) const;
 };
 
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../exceptions.hpp"
+
+/**
+ * A list of strings stored one after the other inside a single character buffer, each string being referred to
+ * by an offset/length handle.
+ *
+ * Editing a string appends its new value at the end of the buffer, so existing characters are never modified.
+ * The buffer is shared between copies of a pool, which makes copying a pool (e.g. to snapshot it) cheap: the first
+ * edit made on a pool sharing its buffer copies (and compacts) it beforehand, leaving other copies untouched.
+ * Ids of empty strings are indexed to find free slots without scanning all strings.
+ */
+class StringPool
+{
+private:
+    struct Handle {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+public:
+    /**
+     * Mutable access to a string of the pool, which reads as a `std::string_view` and can be assigned a new value
+     * the same way `set` would.
+     */
+    class Reference
+    {
+    private:
+        StringPool& _pool;
+        size_t _id;
+
+    public:
+        Reference(StringPool& pool, size_t id) : _pool(pool), _id(id) {}
+
+        Reference& operator=(std::string_view value) { _pool.set(_id, value); return *this; }
+        Reference& operator=(const Reference& other) { return *this = std::string_view(other); }
+        Reference& operator+=(std::string_view value) { return *this = std::string(*this).append(value); }
+
+        operator std::string_view() const { return std::as_const(_pool)[_id]; }
+        operator std::string() const { return std::string(std::string_view(*this)); }
+
+        [[nodiscard]] size_t size() const { return std::string_view(*this).size(); }
+        [[nodiscard]] bool empty() const { return std::string_view(*this).empty(); }
+    };
+
+    /**
+     * Iterates over strings of the pool as `std::string_view`, with the same lifetime as the ones from `operator[]`
+     */
+    class ConstIterator
+    {
+    private:
+        const StringPool* _pool = nullptr;
+        size_t _id = 0;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        ConstIterator() = default;
+        ConstIterator(const StringPool* pool, size_t id) : _pool(pool), _id(id) {}
+
+        std::string_view operator*() const { return (*_pool)[_id]; }
+        std::string_view operator[](difference_type offset) const { return (*_pool)[_id + offset]; }
+
+        ConstIterator& operator++() { ++_id; return *this; }
+        ConstIterator operator++(int) { ConstIterator it = *this; ++_id; return it; }
+        ConstIterator& operator--() { --_id; return *this; }
+        ConstIterator operator--(int) { ConstIterator it = *this; --_id; return it; }
+        ConstIterator& operator+=(difference_type offset) { _id += offset; return *this; }
+        ConstIterator& operator-=(difference_type offset) { _id -= offset; return *this; }
+
+        friend ConstIterator operator+(ConstIterator it, difference_type offset) { return it += offset; }
+        friend ConstIterator operator+(difference_type offset, ConstIterator it) { return it += offset; }
+        friend ConstIterator operator-(ConstIterator it, difference_type offset) { return it -= offset; }
+        friend difference_type operator-(const ConstIterator& a, const ConstIterator& b) { return (difference_type)a._id - (difference_type)b._id; }
+
+        bool operator==(const ConstIterator& other) const { return _id == other._id; }
+        auto operator<=>(const ConstIterator& other) const { return _id <=> other._id; }
+    };
+
+private:
+    std::shared_ptr<std::string> _buffer;
+    std::vector<Handle> _handles;
+    std::set<size_t> _empty_ids;
+    /// Number of characters inside the buffer which are not referenced anymore since strings were edited
+    size_t _unused_chars = 0;
+
+public:
+    StringPool() : _buffer(std::make_shared<std::string>())
+    {}
+
+    explicit StringPool(const std::vector<std::string>& strings) : StringPool()
+    {
+        size_t total_size = 0;
+        for(const std::string& string : strings)
+            total_size += string.size();
+        _buffer->reserve(total_size);
+        _handles.reserve(strings.size());
+
+        for(const std::string& string : strings)
+            this->push_back(string);
+    }
+
+    [[nodiscard]] size_t size() const { return _handles.size(); }
+    [[nodiscard]] bool empty() const { return _handles.empty(); }
+    [[nodiscard]] size_t buffer_size() const { return _buffer->size(); }
+
+    /**
+     * Views returned by the pool do not own their characters: they are invalidated by any later edition of the pool
+     * (`set`, `push_back`, `resize`...), which can reallocate or compact its buffer. Copy them into a `std::string`
+     * to keep them around.
+     */
+    [[nodiscard]] std::string_view operator[](size_t id) const
+    {
+        const Handle& handle = _handles[id];
+        return { _buffer->data() + handle.offset, handle.length };
+    }
+
+    [[nodiscard]] Reference operator[](size_t id) { return { *this, id }; }
+
+    [[nodiscard]] ConstIterator begin() const { return { this, 0 }; }
+    [[nodiscard]] ConstIterator end() const { return { this, _handles.size() }; }
+
+    [[nodiscard]] std::string_view at(size_t id) const
+    {
+        if(id >= _handles.size())
+            throw LandstalkerException("String #" + std::to_string(id) + " does not exist in string pool");
+        return (*this)[id];
+    }
+
+    /**
+     * @return true if both pools refer to the same characters for the given string, meaning it was not edited
+     *         in any of the pools since one was copied from the other
+     */
+    [[nodiscard]] bool shares_string(const StringPool& other, size_t id) const
+    {
+        if(_buffer != other._buffer || id >= _handles.size() || id >= other._handles.size())
+            return false;
+        return _handles[id].offset == other._handles[id].offset && _handles[id].length == other._handles[id].length;
+    }
+
+    void set(size_t id, std::string_view value)
+    {
+        if(id >= _handles.size())
+            throw LandstalkerException("String #" + std::to_string(id) + " does not exist in string pool");
+
+        Handle handle = this->append(value);
+        _unused_chars += _handles[id].length;
+        _handles[id] = handle;
+        if(value.empty())
+            _empty_ids.insert(id);
+        else
+            _empty_ids.erase(id);
+    }
+
+    size_t push_back(std::string_view value)
+    {
+        size_t id = _handles.size();
+        _handles.emplace_back(this->append(value));
+        if(value.empty())
+            _empty_ids.insert(id);
+        return id;
+    }
+
+    void resize(size_t size)
+    {
+        for(size_t id = size ; id < _handles.size() ; ++id)
+        {
+            _unused_chars += _handles[id].length;
+            _empty_ids.erase(id);
+        }
+        for(size_t id = _handles.size() ; id < size ; ++id)
+            _empty_ids.insert(id);
+        _handles.resize(size);
+    }
+
+    void clear()
+    {
+        _buffer = std::make_shared<std::string>();
+        _handles.clear();
+        _empty_ids.clear();
+        _unused_chars = 0;
+    }
+
+    /**
+     * @return the id of the first empty string starting from `initial_id`, or the size of the pool if there is none
+     */
+    [[nodiscard]] size_t first_empty(size_t initial_id = 0) const
+    {
+        auto it = _empty_ids.lower_bound(initial_id);
+        if(it == _empty_ids.end())
+            return _handles.size();
+        return *it;
+    }
+
+    [[nodiscard]] std::vector<std::string> to_vector() const
+    {
+        std::vector<std::string> strings;
+        strings.reserve(_handles.size());
+        for(size_t id = 0 ; id < _handles.size() ; ++id)
+            strings.emplace_back((*this)[id]);
+        return strings;
+    }
+
+private:
+    Handle append(std::string_view value)
+    {
+        // Value might point inside our own buffer, which could be reallocated or replaced below
+        if(!value.empty() && value.data() >= _buffer->data() && value.data() < _buffer->data() + _buffer->size())
+            return this->append(std::string(value));
+
+        if(_buffer.use_count() > 1)
+            this->compact();
+        else if(_unused_chars > _buffer->size() / 2 && _unused_chars > 0x1000)
+            this->compact();
+
+        Handle handle { (uint32_t)_buffer->size(), (uint32_t)value.size() };
+        _buffer->append(value);
+        return handle;
+    }
+
+    /**
+     * Copies all referenced strings inside a new buffer owned by this pool only, removing unused characters
+     */
+    void compact()
+    {
+        auto buffer = std::make_shared<std::string>();
+        buffer->reserve(_buffer->size() - _unused_chars);
+        for(Handle& handle : _handles)
+        {
+            uint32_t new_offset = buffer->size();
+            buffer->append(*_buffer, handle.offset, handle.length);
+            handle.offset = new_offset;
+        }
+        _buffer = buffer;
+        _unused_chars = 0;
+    }
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace threadtools {
+
+    /**
+     * Resolves a user-provided thread count, where 0 means "use as many threads as the hardware supports".
+     */
+    [[nodiscard]] inline size_t resolve_thread_count(size_t thread_count)
+    {
+        if(thread_count == 0)
+            thread_count = std::thread::hardware_concurrency();
+        return std::max<size_t>(thread_count, 1);
+    }
+
+    /**
+     * Calls `func(i)` for every i in [0, count) using a pool of worker threads pulling indices one at a time.
+     * Calls are made in an unspecified order, so `func` must only write to per-index state.
+     * If any call throws, remaining indices are skipped and the first exception is rethrown in the calling thread.
+     *
+     * @param count the number of indices to process
+     * @param func the function to call for each index
+     * @param thread_count the maximum number of threads to use (0 means hardware concurrency)
+     */
+    template<typename Func>
+    inline void parallel_for(size_t count, Func&& func, size_t thread_count = 0)
+    {
+        thread_count = std::min(resolve_thread_count(thread_count), count);
+        if(thread_count <= 1)
+        {
+            for(size_t i=0 ; i<count ; ++i)
+                func(i);
+            return;
+        }
+
+        std::atomic<size_t> next_index = 0;
+        std::atomic<bool> failed = false;
+        std::exception_ptr first_exception;
+        std::mutex exception_mutex;
+
+        auto worker = [&]() {
+            while(!failed)
+            {
+                size_t i = next_index++;
+                if(i >= count)
+                    return;
+
+                try
+                {
+                    func(i);
+                }
+                catch(...)
+                {
+                    std::lock_guard lock(exception_mutex);
+                    if(!first_exception)
+                        first_exception = std::current_exception();
+                    failed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count - 1);
+        for(size_t i=1 ; i<thread_count ; ++i)
+            threads.emplace_back(worker);
+        worker();
+        for(std::thread& thread : threads)
+            thread.join();
+
+        if(first_exception)
+            std::rethrow_exception(first_exception);
+    }
+}